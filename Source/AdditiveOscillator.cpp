@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    AdditiveOscillator.cpp
+
+    Table analysis, partial splatting and overlap-add for the additive oscillator.
+
+  ==============================================================================
+*/
+
+#include "AdditiveOscillator.h"
+
+namespace
+{
+    constexpr int kernelOversampling = 64;
+    constexpr float twoPi = juce::MathConstants<float>::twoPi;
+
+    // Blackman-Harris kernel sampled across its main lobe, plus the overlap-add window
+    // that swaps the kernel's window for a triangle over the central two hops
+    struct AdditiveTables
+    {
+        std::array<float, AdditiveOscillator::kernelHalfWidth * kernelOversampling + 2> kernel;
+        std::array<float, AdditiveOscillator::hopSize * 2> synthesisWindow;
+
+        static const AdditiveTables& get()
+        {
+            static const AdditiveTables tables;
+            return tables;
+        }
+
+        float kernelAt(float offset) const
+        {
+            const float position = std::abs(offset) * kernelOversampling;
+            const int index = static_cast<int>(position);
+            if (index >= AdditiveOscillator::kernelHalfWidth * kernelOversampling)
+                return 0.0f;
+
+            const float fraction = position - index;
+            return kernel[static_cast<size_t>(index)] + fraction * (kernel[static_cast<size_t>(index + 1)] - kernel[static_cast<size_t>(index)]);
+        }
+
+    private:
+        AdditiveTables()
+        {
+            constexpr int size = AdditiveOscillator::frameSize;
+            constexpr int hop = AdditiveOscillator::hopSize;
+
+            auto window = [](int n)
+            {
+                const double x = juce::MathConstants<double>::twoPi * n / size;
+                return 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2.0 * x) - 0.01168 * std::cos(3.0 * x);
+            };
+
+            // Real transform of the centred window at fractional bin offsets
+            for (size_t i = 0; i < kernel.size(); ++i)
+            {
+                const double offset = static_cast<double>(i) / kernelOversampling;
+                double sum = 0.0;
+                for (int m = -size / 2; m < size / 2; ++m)
+                    sum += window(m + size / 2) * std::cos(juce::MathConstants<double>::twoPi * offset * m / size);
+                kernel[i] = static_cast<float>(sum);
+            }
+            kernel.back() = 0.0f;
+
+            for (int i = 0; i < hop * 2; ++i)
+            {
+                const int m = i - hop;
+                const double triangle = 1.0 - std::abs(m) / static_cast<double>(hop);
+                synthesisWindow[static_cast<size_t>(i)] = static_cast<float>(triangle / window(m + size / 2));
+            }
+        }
+    };
+}
+
+//==============================================================================
+AdditiveOscillator::AdditiveOscillator()
+{
+    frameL.assign(frameSize * 2, 0.0f);
+    frameR.assign(frameSize * 2, 0.0f);
+    accumulatorL.assign(hopSize * 2, 0.0f);
+    accumulatorR.assign(hopSize * 2, 0.0f);
+    partialGain.fill(1.0f);
+    partialBin.fill(0.0f);
+    reset();
+
+    // Build the shared kernel here so no voice ever does it on the audio thread
+    AdditiveTables::get();
+}
+
+void AdditiveOscillator::analyse(const std::array<float, 1024>& table, const juce::dsp::FFT& fft, float* scratch, TableSpectrum& spectrum)
+{
+    static_assert(frameSize == 1024, "Table bins are read as frame bins");
+
+    std::copy(table.begin(), table.end(), scratch);
+    std::fill(scratch + frameSize, scratch + frameSize * 2, 0.0f);
+    fft.performRealOnlyForwardTransform(scratch, true);
+
+    spectrum.amplitude[0] = 0.0f;
+    spectrum.phase[0] = 0.0f;
+
+    for (int bin = 1; bin < TableSpectrum::numBins; ++bin)
+    {
+        const float re = scratch[bin * 2];
+        const float im = scratch[bin * 2 + 1];
+        const float scale = bin == frameSize / 2 ? 1.0f / frameSize : 2.0f / frameSize;
+
+        spectrum.amplitude[static_cast<size_t>(bin)] = std::sqrt(re * re + im * im) * scale;
+        spectrum.phase[static_cast<size_t>(bin)] = std::atan2(im, re);
+    }
+}
+
+void AdditiveOscillator::reset()
+{
+    std::fill(accumulatorL.begin(), accumulatorL.end(), 0.0f);
+    std::fill(accumulatorR.begin(), accumulatorR.end(), 0.0f);
+    partialPhase.fill(0.0f);
+    readyPosition = hopSize;
+    numActivePartials = 0;
+}
+
+//==============================================================================
+void AdditiveOscillator::render(float* left, float* right, int numSamples, const TableSpectrum& spectrumL, const TableSpectrum& spectrumR,
+                                float increment, float tilt, float oddEven, float stretch)
+{
+    while (numSamples > 0)
+    {
+        if (readyPosition == hopSize)
+        {
+            synthesiseFrame(spectrumL, spectrumR, increment, tilt, oddEven, stretch);
+            readyPosition = 0;
+        }
+
+        const int count = juce::jmin(numSamples, hopSize - readyPosition);
+        juce::FloatVectorOperations::copy(left, readyL.data() + readyPosition, count);
+        juce::FloatVectorOperations::copy(right, readyR.data() + readyPosition, count);
+
+        left += count;
+        right += count;
+        numSamples -= count;
+        readyPosition += count;
+    }
+}
+
+void AdditiveOscillator::synthesiseFrame(const TableSpectrum& spectrumL, const TableSpectrum& spectrumR,
+                                         float increment, float tilt, float oddEven, float stretch)
+{
+    if (tilt != gainTilt || oddEven != gainOddEven)
+        updatePartialGains(tilt, oddEven);
+
+    // Place partials for this note, dropping those whose kernel would cross Nyquist.
+    // Stretch only raises partials, so the first one over the limit ends the set.
+    const float limit = static_cast<float>(frameSize / 2 - kernelHalfWidth);
+    numActivePartials = 0;
+
+    for (int harmonic = 1; harmonic <= maxPartials; ++harmonic)
+    {
+        const float h = static_cast<float>(harmonic);
+        const float bin = increment * h * std::sqrt(1.0f + stretch * h * h);
+        if (bin >= limit)
+            break;
+
+        partialBin[static_cast<size_t>(harmonic)] = bin;
+        numActivePartials = harmonic;
+    }
+
+    splat(spectrumL, frameL.data());
+    fft.performRealOnlyInverseTransform(frameL.data());
+    overlapAdd(frameL.data(), accumulatorL);
+
+    splat(spectrumR, frameR.data());
+    fft.performRealOnlyInverseTransform(frameR.data());
+    overlapAdd(frameR.data(), accumulatorR);
+
+    // The first hop of the accumulator is complete; hand it out and slide the second down
+    std::copy(accumulatorL.begin(), accumulatorL.begin() + hopSize, readyL.begin());
+    std::copy(accumulatorR.begin(), accumulatorR.begin() + hopSize, readyR.begin());
+    std::copy(accumulatorL.begin() + hopSize, accumulatorL.end(), accumulatorL.begin());
+    std::copy(accumulatorR.begin() + hopSize, accumulatorR.end(), accumulatorR.begin());
+    std::fill(accumulatorL.begin() + hopSize, accumulatorL.end(), 0.0f);
+    std::fill(accumulatorR.begin() + hopSize, accumulatorR.end(), 0.0f);
+
+    // Advance every partial to the next frame centre
+    const float hopRadians = twoPi * hopSize / frameSize;
+    for (int harmonic = 1; harmonic <= numActivePartials; ++harmonic)
+    {
+        auto& phase = partialPhase[static_cast<size_t>(harmonic)];
+        phase = std::fmod(phase + hopRadians * partialBin[static_cast<size_t>(harmonic)], twoPi);
+    }
+}
+
+void AdditiveOscillator::updatePartialGains(float tilt, float oddEven)
+{
+    gainTilt = tilt;
+    gainOddEven = oddEven;
+
+    // Positive balance thins the even harmonics, negative the odd ones
+    const float exponent = tilt / 6.0206f;
+    const float oddGain = juce::jmin(1.0f, 1.0f + oddEven);
+    const float evenGain = juce::jmin(1.0f, 1.0f - oddEven);
+
+    for (int harmonic = 1; harmonic <= maxPartials; ++harmonic)
+        partialGain[static_cast<size_t>(harmonic)] = std::pow(static_cast<float>(harmonic), exponent)
+                                                     * ((harmonic & 1) != 0 ? oddGain : evenGain);
+}
+
+void AdditiveOscillator::splat(const TableSpectrum& spectrum, float* bins) const
+{
+    const auto& tables = AdditiveTables::get();
+    std::fill(bins, bins + frameSize * 2, 0.0f);
+
+    for (int harmonic = 1; harmonic <= numActivePartials; ++harmonic)
+    {
+        const auto index = static_cast<size_t>(harmonic);
+        const float amplitude = 0.5f * spectrum.amplitude[index] * partialGain[index];
+        if (amplitude < 1.0e-6f)
+            continue;
+
+        // Phase at the frame centre; bin k of a centred frame also picks up (-1)^k
+        const float phase = spectrum.phase[index] + partialPhase[index];
+        const float re = amplitude * std::cos(phase);
+        const float im = amplitude * std::sin(phase);
+        const float bin = partialBin[index];
+
+        const int first = juce::jmax(0, static_cast<int>(std::ceil(bin - kernelHalfWidth)));
+        const int last = static_cast<int>(std::floor(bin + kernelHalfWidth));
+        for (int k = first; k <= last; ++k)
+        {
+            const float weight = tables.kernelAt(k - bin) * ((k & 1) != 0 ? -1.0f : 1.0f);
+            bins[k * 2] += re * weight;
+            bins[k * 2 + 1] += im * weight;
+        }
+
+        // Low partials also catch the tail of their negative-frequency image
+        for (int k = 0; k <= static_cast<int>(kernelHalfWidth - bin); ++k)
+        {
+            const float weight = tables.kernelAt(k + bin) * ((k & 1) != 0 ? -1.0f : 1.0f);
+            bins[k * 2] += re * weight;
+            bins[k * 2 + 1] -= im * weight;
+        }
+    }
+}
+
+void AdditiveOscillator::overlapAdd(float* frame, std::vector<float>& accumulator) const
+{
+    const auto& window = AdditiveTables::get().synthesisWindow;
+    const float* centre = frame + frameSize / 2 - hopSize;
+
+    for (int i = 0; i < hopSize * 2; ++i)
+        accumulator[static_cast<size_t>(i)] += centre[i] * window[static_cast<size_t>(i)];
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    AdditiveOscillator.h
+
+    Inverse-FFT additive resynthesis of the DUMUMUB wavetables.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+// Partial amplitudes and phases of one 1024-sample table (bin 0 = DC, unused)
+struct TableSpectrum
+{
+    static constexpr int numBins = 513;
+    std::array<float, numBins> amplitude {};
+    std::array<float, numBins> phase {};
+};
+
+//==============================================================================
+/**
+ * Additive Oscillator - Inverse-FFT Overlap-Add Partial Synthesis
+ *
+ * Rebuilds a voice from up to 512 harmonic partials taken from the FFT of its
+ * tables. Each hop, every partial below Nyquist is splatted into a spectrum
+ * as a few bins of a Blackman-Harris kernel, one inverse FFT per channel
+ * turns the whole set into a frame, and frames are overlap-added with a
+ * triangle window (divided by the kernel's window) at a quarter-frame hop.
+ * The FFT dominates the cost, so it barely grows with the partial count.
+ *
+ * Per-partial shaping: spectral tilt in dB/octave, odd/even balance, and
+ * piano-style inharmonic stretch (partial h sits at h * sqrt(1 + B h^2)).
+ * All buffers are allocated in the constructor.
+ */
+class AdditiveOscillator
+{
+public:
+    static constexpr int fftOrder = 10;
+    static constexpr int frameSize = 1 << fftOrder;
+    static constexpr int hopSize = frameSize / 4;
+    static constexpr int maxPartials = TableSpectrum::numBins - 1;
+    static constexpr int kernelHalfWidth = 4;
+
+    AdditiveOscillator();
+
+    // Partial amplitudes and phases of a table; scratch must hold 2 * frameSize floats
+    static void analyse(const std::array<float, 1024>& table, const juce::dsp::FFT& fft, float* scratch, TableSpectrum& spectrum);
+
+    // Clear the overlap-add state and restart every partial at the table's own phase
+    void reset();
+
+    // Raw stereo output. The frame is as long as the table, so the phase increment in
+    // table samples is also the fundamental in frame bins.
+    void render(float* left, float* right, int numSamples, const TableSpectrum& spectrumL, const TableSpectrum& spectrumR,
+                float increment, float tilt, float oddEven, float stretch);
+
+private:
+    void synthesiseFrame(const TableSpectrum& spectrumL, const TableSpectrum& spectrumR,
+                         float increment, float tilt, float oddEven, float stretch);
+    void updatePartialGains(float tilt, float oddEven);
+    void splat(const TableSpectrum& spectrum, float* bins) const;
+    void overlapAdd(float* frame, std::vector<float>& accumulator) const;
+
+    juce::dsp::FFT fft { fftOrder };
+
+    std::vector<float> frameL, frameR;
+    std::vector<float> accumulatorL, accumulatorR;
+    std::array<float, hopSize> readyL, readyR;
+    int readyPosition = hopSize;
+
+    // Running phase, bin position and shaping gain per partial (index = harmonic number)
+    std::array<float, maxPartials + 1> partialPhase;
+    std::array<float, maxPartials + 1> partialBin;
+    std::array<float, maxPartials + 1> partialGain;
+    int numActivePartials = 0;
+    float gainTilt = 0.0f;
+    float gainOddEven = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AdditiveOscillator)
+};
@@ -0,0 +1,158 @@
+/*
+  ==============================================================================
+
+    AnalyticOscillator.h
+
+    Band-limited analytic versions of the basic DUMUMUB waveform templates.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+/**
+ * Analytic Oscillator - PolyBLEP/PolyBLAMP Basic Shapes
+ *
+ * Evaluates the sine, square, triangle and sawtooth templates directly from
+ * phase, matching their polarity and phase exactly. Square and saw steps are
+ * smoothed with two-sample PolyBLEP residuals, and triangle corners with the
+ * matching PolyBLAMP, so they alias far less than a truncating table read.
+ *
+ * Shapes are rendered a run at a time from a phase array: phase accumulation
+ * stays a serial loop in the voice, and each evaluation loop here has no
+ * cross-sample dependency so the compiler can vectorise it.
+ */
+class AnalyticOscillator
+{
+public:
+    enum class Shape
+    {
+        none = 0,
+        sine,
+        square,
+        triangle,
+        saw
+    };
+
+    static constexpr int tableSize = 1024;
+
+    // Largest per-sample difference still counted as an unmodified template (absorbs
+    // rounding from state round-trips and table copies, far below any audible edit)
+    static constexpr float matchTolerance = 1.0e-5f;
+
+    // Which template a table holds unmodified, or none
+    static Shape classify(const std::array<float, tableSize>& table,
+                          const std::array<float, tableSize>& sine, const std::array<float, tableSize>& square,
+                          const std::array<float, tableSize>& triangle, const std::array<float, tableSize>& saw)
+    {
+        if (matches(table, sine))     return Shape::sine;
+        if (matches(table, square))   return Shape::square;
+        if (matches(table, triangle)) return Shape::triangle;
+        if (matches(table, saw))      return Shape::saw;
+        return Shape::none;
+    }
+
+    // Evaluate a shape at phases given in table samples [0, 1024). increment is the
+    // phase step in table samples; output may alias the phase array.
+    static void render(Shape shape, const float* phase, float increment, float* output, int numSamples)
+    {
+        constexpr float toCycles = 1.0f / tableSize;
+
+        // Residual width in cycles, kept under half a cycle so the two corrections never overlap
+        const float dt = juce::jlimit(1.0e-6f, 0.49f, increment * toCycles);
+        const float inverseDt = 1.0f / dt;
+
+        switch (shape)
+        {
+            case Shape::sine:
+                for (int i = 0; i < numSamples; ++i)
+                    output[i] = sine(phase[i] * toCycles);
+                break;
+
+            case Shape::square:
+                // -1 over the first half, +1 over the second: up at 0.5, down at the wrap
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float p = phase[i] * toCycles;
+                    const float naive = p <= 0.5f ? -1.0f : 1.0f;
+                    output[i] = naive + 2.0f * blep(distance(p, 0.5f) * inverseDt) - 2.0f * blep(distance(p, 0.0f) * inverseDt);
+                }
+                break;
+
+            case Shape::triangle:
+                // 0 -> -1 at 0.25 -> +1 at 0.75 -> 0; slope changes by 8 per cycle at each corner
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float p = phase[i] * toCycles;
+                    const float naive = p < 0.25f ? -4.0f * p : (p < 0.75f ? 4.0f * p - 2.0f : 4.0f - 4.0f * p);
+                    output[i] = naive + 8.0f * dt * (blamp(distance(p, 0.25f) * inverseDt) - blamp(distance(p, 0.75f) * inverseDt));
+                }
+                break;
+
+            case Shape::saw:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float p = phase[i] * toCycles;
+                    output[i] = 2.0f * p - 1.0f - 2.0f * blep(distance(p, 0.0f) * inverseDt);
+                }
+                break;
+
+            case Shape::none:
+            default:
+                juce::FloatVectorOperations::clear(output, numSamples);
+                break;
+        }
+    }
+
+private:
+    // Maximum absolute error against a template within matchTolerance
+    static bool matches(const std::array<float, tableSize>& table, const std::array<float, tableSize>& shape)
+    {
+        for (int i = 0; i < tableSize; ++i)
+            if (std::abs(table[static_cast<size_t>(i)] - shape[static_cast<size_t>(i)]) > matchTolerance)
+                return false;
+        return true;
+    }
+
+    // Signed distance in cycles from an edge, wrapped to the nearest side
+    static float distance(float p, float edge)
+    {
+        float d = p - edge;
+        d -= d > 0.5f ? 1.0f : 0.0f;
+        d += d < -0.5f ? 1.0f : 0.0f;
+        return d;
+    }
+
+    // Band-limited minus naive unit step, t in samples from the step
+    static float blep(float t)
+    {
+        if (t <= -1.0f || t >= 1.0f)
+            return 0.0f;
+        return t < 0.0f ? 0.5f * (t + 1.0f) * (t + 1.0f) : -0.5f * (1.0f - t) * (1.0f - t);
+    }
+
+    // Integral of blep: band-limited minus naive unit slope change
+    static float blamp(float t)
+    {
+        const float u = 1.0f - std::abs(t);
+        return u > 0.0f ? u * u * u * (1.0f / 6.0f) : 0.0f;
+    }
+
+    // -sin(2 pi p) (the template's polarity), folded to a quarter wave and a 9th-order series
+    static float sine(float p)
+    {
+        float x = p - 0.5f;
+        x = x > 0.25f ? 0.5f - x : x;
+        x = x < -0.25f ? -0.5f - x : x;
+
+        const float y = juce::MathConstants<float>::twoPi * x;
+        const float y2 = y * y;
+        return y * (1.0f + y2 * (-1.0f / 6.0f + y2 * (1.0f / 120.0f + y2 * (-1.0f / 5040.0f + y2 * (1.0f / 362880.0f)))));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalyticOscillator)
+};
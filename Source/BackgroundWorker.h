@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    BackgroundWorker.h
+
+    Low-priority worker thread for DUMUMUB wavetable synthesizer.
+    Runs rebuilds and file work off the audio and message threads.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <vector>
+
+//==============================================================================
+/**
+ * Background Worker - Keyed Job Queue
+ *
+ * Jobs are posted with a key. Posting a job whose key is already queued
+ * replaces the queued one, so a burst of identical requests (e.g. several
+ * prepareToPlay calls during host reconfiguration) collapses into one rebuild.
+ * Jobs run one at a time, in order, on a single low-priority thread, so a
+ * long job holds up everything queued behind it; owners keep long jobs on a
+ * worker of their own.
+ */
+class BackgroundWorker : private juce::Thread
+{
+public:
+    explicit BackgroundWorker(const juce::String& threadName = "DUMUMUB Background Worker")
+        : juce::Thread(threadName)
+    {
+        startThread(juce::Thread::Priority::low);
+    }
+
+    ~BackgroundWorker() override
+    {
+        stop();
+    }
+
+    // Queue a job, replacing any queued job with the same key
+    void post(const juce::String& key, std::function<void()> job)
+    {
+        {
+            const juce::ScopedLock sl(queueLock);
+
+            bool replaced = false;
+            for (auto& queued : queue)
+            {
+                if (queued.key == key)
+                {
+                    queued.job = std::move(job);
+                    replaced = true;
+                    break;
+                }
+            }
+
+            if (!replaced)
+                queue.push_back({ key, std::move(job) });
+        }
+
+        notify();
+    }
+
+    // Drop queued jobs and wait for the running one to finish (call before owners are destroyed)
+    void stop()
+    {
+        {
+            const juce::ScopedLock sl(queueLock);
+            queue.clear();
+        }
+        stopThread(10000);
+    }
+
+    bool isIdle() const
+    {
+        const juce::ScopedLock sl(queueLock);
+        return queue.empty() && !running;
+    }
+
+private:
+    struct QueuedJob
+    {
+        juce::String key;
+        std::function<void()> job;
+    };
+
+    void run() override
+    {
+        while (!threadShouldExit())
+        {
+            std::function<void()> next;
+            {
+                const juce::ScopedLock sl(queueLock);
+                if (!queue.empty())
+                {
+                    next = std::move(queue.front().job);
+                    queue.erase(queue.begin());
+                    running = true;
+                }
+            }
+
+            if (next == nullptr)
+            {
+                wait(-1);
+                continue;
+            }
+
+            next();
+
+            const juce::ScopedLock sl(queueLock);
+            running = false;
+        }
+    }
+
+    juce::CriticalSection queueLock;
+    std::vector<QueuedJob> queue;
+    bool running = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundWorker)
+};
@@ -24,12 +24,16 @@ Canvas::Canvas(DUMUMUB003AudioProcessor& p) : audioProcessor(p)
 
     background = ImageFileFormat::loadFrom(BinaryData::CANVAS_png, BinaryData::CANVAS_pngSize);
 
+    // Start feeding the oscilloscope now that there is something to draw it
+    audioProcessor.getScope().setActive(true);
+
     startTimerHz(30);
 
 }
 
 Canvas::~Canvas()
 {
+    audioProcessor.getScope().setActive(false);
 }
 
 void Canvas::paint (juce::Graphics& g)
@@ -39,11 +43,16 @@ void Canvas::paint (juce::Graphics& g)
     {
       g.drawImage(background, 0, 0, getWidth(), getHeight(), 0, 0, background.getWidth(), background.getHeight());
 
-      // Real-time oscilloscope display
-        std::array<float, 1024> bufferLeft = audioProcessor.getCurrentBufferL();
-        std::array<float, 1024> bufferRight = audioProcessor.getCurrentBufferR();
-        drawOscilloscope(g, bufferLeft, parentComponent->getGreen(), 0);
-        drawOscilloscope(g, bufferRight, parentComponent->getGreen(), 250);
+      // Real-time oscilloscope display, or the spectrum view in its place
+        if (spectrumVisible)
+        {
+            drawSpectrum(g, parentComponent->getGreen(), parentComponent->getBlue(), parentComponent->getRed());
+        }
+        else if (scopeReady)
+        {
+            drawOscilloscope(g, scopeColumns[0], parentComponent->getGreen(), 0);
+            drawOscilloscope(g, scopeColumns[1], parentComponent->getGreen(), 250);
+        }
       
       int lineThickness = 2;
 
@@ -85,6 +94,14 @@ void Canvas::resized()
 
 void Canvas::mouseDown(const MouseEvent& event)
 {
+    // Right-click swaps the oscilloscope for the spectrum view
+    if (event.mods.isPopupMenu())
+    {
+      toggleSpectrum();
+      repaint();
+      return;
+    }
+
     Point<int> mousePos = event.getPosition(); 
     int x = mousePos.getX();
     int y = mousePos.getY();
@@ -117,6 +134,7 @@ void Canvas::mouseDown(const MouseEvent& event)
 
 void Canvas::mouseDrag(const MouseEvent& event)
 {
+    DUMUMUB_TRACE_SCOPE ("gui", "canvasDrag");
     Point<int> mousePos = event.getPosition(); 
     int x = mousePos.getX();
     int y = mousePos.getY();
@@ -171,21 +189,91 @@ void Canvas::mouseDrag(const MouseEvent& event)
     }
 }
 
-void Canvas::drawOscilloscope(Graphics& g, std::array<float, 1024> array, Colour colour, int shift)
+void Canvas::drawOscilloscope(Graphics& g, const std::vector<ScopeBuffer::Column>& columns, Colour colour, int shift)
 {
   g.setColour(colour);
-  for (int i = 0; i < array.size(); ++i)
+  float prevTop = 0.0f;
+  float prevBottom = 0.0f;
+  for (int i = 0; i < columns.size(); ++i)
     {
-      int x = i;
-      int y = static_cast<int>(((array[i] + 1) / 2) * 250);
-      int prevx = std::max(i - 1, 0);
-      int prvy = static_cast<int>(((array[prevx] + 1) / 2) * 250);
-      
-      g.drawLine(x, y + shift, prevx, prvy + shift, 2); 
+      float top = ((columns[i].minimum + 1) / 2) * 250;
+      float bottom = ((columns[i].maximum + 1) / 2) * 250;
+
+      // Stretch each column to meet the previous one so the trace stays connected
+      if (i > 0)
+      {
+        top = std::min(top, prevBottom);
+        bottom = std::max(bottom, prevTop);
+      }
+      prevTop = ((columns[i].minimum + 1) / 2) * 250;
+      prevBottom = ((columns[i].maximum + 1) / 2) * 250;
+
+      g.fillRect(static_cast<float>(i), top + shift, 2.0f, bottom - top + 2.0f);
     }
 }
 
+void Canvas::drawSpectrum(Graphics& g, Colour outputColour, Colour leftColour, Colour rightColour)
+{
+  // Output spectrum across the top half, log frequency from 20 Hz to Nyquist
+  Path outputPath;
+  for (int i = 0; i < spectrumView.output.size(); ++i)
+    {
+      const auto point = spectrumView.output[i];
+      const float x = point.x * getWidth();
+      const float y = point.y * 250;
+      if (i == 0)
+        outputPath.startNewSubPath(x, y);
+      else
+        outputPath.lineTo(x, y);
+    }
+  g.setColour(outputColour);
+  g.strokePath(outputPath, PathStrokeType(2.0f));
+
+  // Table harmonics as stems across the bottom half, log harmonic number from 1 to 512
+  auto drawHarmonics = [&](const std::vector<Point<float>>& points, Colour colour, float offset)
+  {
+    g.setColour(colour);
+    for (const auto& point : points)
+      {
+        const float x = point.x * (getWidth() - 4) + offset;
+        g.drawLine(x, 250 + point.y * 250, x, 500, 2);
+      }
+  };
+  drawHarmonics(spectrumView.harmonicsL, leftColour, 1.0f);
+  drawHarmonics(spectrumView.harmonicsR, rightColour, 3.0f);
+}
+
 void Canvas::timerCallback()
 {
+    // Nothing to draw while the editor is minimised or covered
+    if (!isShowing())
+      return;
+
+    if (spectrumVisible)
+    {
+      // Analysis runs on the background worker; only ask for a pass when the output or the
+      // tables have moved on, and pick up whatever it last finished
+      DUMUMUB003AudioProcessorEditor* parentComponent = dynamic_cast<DUMUMUB003AudioProcessorEditor*>(getParentComponent());
+      if (parentComponent != nullptr)
+      {
+        const auto scopePosition = audioProcessor.getScope().getWritePosition();
+        const auto& tableL = parentComponent->getWaveTableL();
+        const auto& tableR = parentComponent->getWaveTableR();
+        if (scopePosition != analysedScopePosition || tableL != analysedTableL || tableR != analysedTableR)
+        {
+          analysedScopePosition = scopePosition;
+          analysedTableL = tableL;
+          analysedTableR = tableR;
+          audioProcessor.requestSpectrumAnalysis(tableL, tableR);
+        }
+      }
+      audioProcessor.getSpectrumView(spectrumView);
+    }
+    else
+    {
+      // Trigger and decimate on the message thread; the audio thread only fills the ring
+      scopeReady = audioProcessor.getScope().extract(scopeColumns, getWidth());
+    }
+
     repaint();
 }
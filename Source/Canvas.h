@@ -23,7 +23,8 @@
  * Features:
  * - Real-time wavetable visualization for both stereo channels
  * - Mouse-based wavetable editing with drag support
- * - Oscilloscope display for live audio monitoring
+ * - Triggered min/max oscilloscope display for live audio monitoring
+ * - Spectrum view of the output and the tables' harmonics (right-click to toggle)
  * - Independent left/right channel toggle controls
  */
 class Canvas  : public juce::Component, private juce::Timer
@@ -44,7 +45,9 @@ public:
     void toggleRight(bool value) { right = value; }
 
     // Visualization
-    void drawOscilloscope(Graphics& g, std::array<float, 1024> array, Colour colour, int shift);
+    void drawOscilloscope(Graphics& g, const std::vector<ScopeBuffer::Column>& columns, Colour colour, int shift);
+    void drawSpectrum(Graphics& g, Colour outputColour, Colour leftColour, Colour rightColour);
+    void toggleSpectrum() { spectrumVisible = !spectrumVisible; }
 
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Canvas)
@@ -62,6 +65,18 @@ private:
     // Audio Processor Reference
     DUMUMUB003AudioProcessor& audioProcessor;
 
+    // Oscilloscope columns taken from the processor's scope ring on each timer tick
+    std::array<std::vector<ScopeBuffer::Column>, ScopeBuffer::numChannels> scopeColumns;
+    bool scopeReady = false;
+
+    // Spectrum view points from the processor's analyser (replaces the scope while shown)
+    SpectrumAnalyser::View spectrumView;
+    bool spectrumVisible = false;
+
+    // What the last requested analysis was given, so unchanged frames are not re-analysed
+    juce::uint64 analysedScopePosition = 0;
+    std::array<float, 1024> analysedTableL {}, analysedTableR {};
+
     // Background Graphics
     Image background;
 };
@@ -0,0 +1,263 @@
+/*
+  ==============================================================================
+
+    ConvolutionStage.cpp
+
+    Impulse preparation and partitioned convolution for the convolution stage.
+
+  ==============================================================================
+*/
+
+#include "ConvolutionStage.h"
+
+//==============================================================================
+// Everything that depends on one impulse response, built off the audio thread
+struct ConvolutionStage::Engine
+{
+    static constexpr int fftOrder = 9;                      // 2 * partitionSize
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBins = partitionSize + 1;
+    static constexpr int spectrumFloats = numBins * 2;      // Interleaved real/imaginary
+
+    Engine(int partitions) : numPartitions(partitions)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            headReversed[channel].assign(partitionSize, 0.0f);
+            headHistory[channel].assign(partitionSize * 2, 0.0f);
+            inputWindow[channel].assign(partitionSize * 2, 0.0f);
+            tailOutput[channel].assign(partitionSize, 0.0f);
+            tailSpectra[channel].assign(static_cast<size_t>(numPartitions) * spectrumFloats, 0.0f);
+            delayLine[channel].assign(static_cast<size_t>(numPartitions) * spectrumFloats, 0.0f);
+        }
+        fftBuffer.assign(fftSize * 2, 0.0f);
+        accumulator.assign(spectrumFloats, 0.0f);
+        headOutput.assign(partitionSize, 0.0f);
+    }
+
+    juce::dsp::FFT fft { fftOrder };
+    const int numPartitions;
+
+    // Direct-form head: first partition of the impulse, reversed, with a doubled history
+    // so the most recent partitionSize inputs are always contiguous
+    std::vector<float> headReversed[2];
+    std::vector<float> headHistory[2];
+
+    // Overlap-save tail: previous and current input blocks, frequency-domain delay line,
+    // partition spectra and the output block being played out
+    std::vector<float> inputWindow[2];
+    std::vector<float> tailSpectra[2];
+    std::vector<float> delayLine[2];
+    std::vector<float> tailOutput[2];
+    int delayLineIndex[2] = { 0, 0 };
+    int position = 0;
+
+    std::vector<float> fftBuffer;
+    std::vector<float> accumulator;
+    std::vector<float> headOutput;      // Wet output of the run being processed (shared by both channels)
+};
+
+//==============================================================================
+ConvolutionStage::ConvolutionStage()
+{
+}
+
+ConvolutionStage::~ConvolutionStage()
+{
+}
+
+void ConvolutionStage::loadImpulse(const juce::AudioBuffer<float>& impulse, double impulseSampleRate, double outputSampleRate)
+{
+    if (impulse.getNumSamples() == 0 || impulse.getNumChannels() == 0 || impulseSampleRate <= 0.0 || outputSampleRate <= 0.0)
+    {
+        releaseImpulse();
+        return;
+    }
+
+    // Resample to the output rate with linear interpolation, capped to the maximum length
+    const double step = impulseSampleRate / outputSampleRate;
+    const int length = juce::jmin(static_cast<int>((impulse.getNumSamples() - 1) / step) + 1,
+                                  static_cast<int>(maximumImpulseSeconds * outputSampleRate));
+
+    juce::AudioBuffer<float> resampled(2, length);
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* source = impulse.getReadPointer(juce::jmin(channel, impulse.getNumChannels() - 1));
+        float* destination = resampled.getWritePointer(channel);
+
+        for (int i = 0; i < length; ++i)
+        {
+            const double sourcePosition = i * step;
+            const int index = static_cast<int>(sourcePosition);
+            const int next = juce::jmin(index + 1, impulse.getNumSamples() - 1);
+            const float fraction = static_cast<float>(sourcePosition - index);
+            destination[i] = source[index] + fraction * (source[next] - source[index]);
+        }
+    }
+
+    // Normalise to unit energy on the louder channel so long and short impulses sit at similar levels
+    float energy = 0.0f;
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float rms = resampled.getRMSLevel(channel, 0, length);
+        energy = juce::jmax(energy, rms * rms * length);
+    }
+    if (energy > 0.0f)
+        resampled.applyGain(1.0f / std::sqrt(energy));
+
+    // Split into the direct-form head and the uniformly partitioned tail
+    const int numPartitions = juce::jmax(0, (length - 1) / partitionSize);
+    auto newEngine = std::make_unique<Engine>(numPartitions);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* ir = resampled.getReadPointer(channel);
+
+        for (int i = 0; i < juce::jmin(partitionSize, length); ++i)
+            newEngine->headReversed[channel][partitionSize - 1 - i] = ir[i];
+
+        for (int partition = 0; partition < numPartitions; ++partition)
+        {
+            const int start = (partition + 1) * partitionSize;
+            const int count = juce::jmin(partitionSize, length - start);
+
+            auto& fftBuffer = newEngine->fftBuffer;
+            std::fill(fftBuffer.begin(), fftBuffer.end(), 0.0f);
+            std::copy(ir + start, ir + start + count, fftBuffer.begin());
+            newEngine->fft.performRealOnlyForwardTransform(fftBuffer.data(), true);
+
+            std::copy(fftBuffer.begin(), fftBuffer.begin() + Engine::spectrumFloats,
+                      newEngine->tailSpectra[channel].begin() + static_cast<size_t>(partition) * Engine::spectrumFloats);
+        }
+    }
+
+    // Swap in the new engine, then free the old one outside the lock
+    {
+        const juce::SpinLock::ScopedLockType lock(engineLock);
+        std::swap(engine, newEngine);
+    }
+}
+
+void ConvolutionStage::releaseImpulse()
+{
+    std::unique_ptr<Engine> released;
+    {
+        const juce::SpinLock::ScopedLockType lock(engineLock);
+        std::swap(engine, released);
+    }
+}
+
+//==============================================================================
+void ConvolutionStage::process(juce::AudioBuffer<float>& buffer)
+{
+    if (!enabled)
+        return;
+
+    // Pass through dry while a new impulse is being swapped in
+    const juce::SpinLock::ScopedTryLockType lock(engineLock);
+    if (!lock.isLocked() || engine == nullptr)
+        return;
+
+    const float wetGain = mix;
+    const float dryGain = 1.0f - wetGain;
+    const int startPosition = engine->position;
+    const int numChannels = juce::jmin(2, buffer.getNumChannels());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        processChannel(*engine, channel, buffer.getWritePointer(channel), startPosition, buffer.getNumSamples(), wetGain, dryGain);
+
+    engine->position = (startPosition + buffer.getNumSamples()) % partitionSize;
+}
+
+void ConvolutionStage::processChannel(Engine& e, int channel, float* samples, int startPosition, int numSamples, float wetGain, float dryGain)
+{
+    float* history = e.headHistory[channel].data();
+    const float* head = e.headReversed[channel].data();
+    float* window = e.inputWindow[channel].data() + partitionSize;
+    const float* tail = e.tailOutput[channel].data();
+
+    float* wet = e.headOutput.data();
+
+    int position = startPosition;
+
+    // Runs end at partition boundaries, where the tail is processed
+    for (int done = 0; done < numSamples;)
+    {
+        const int run = juce::jmin(numSamples - done, partitionSize - position);
+        float* runSamples = samples + done;
+
+        // New inputs go into the second half of the history first, so output sample k still
+        // reads the previous block's inputs from the first half at history[position + k + 1...]
+        juce::FloatVectorOperations::copy(history + partitionSize + position, runSamples, run);
+        juce::FloatVectorOperations::copy(window + position, runSamples, run);
+
+        // Direct-form head over the newest partitionSize inputs, one vector pass per tap
+        // across the whole run instead of a scalar dot product per sample
+        juce::FloatVectorOperations::copy(wet, tail + position, run);
+        for (int tap = 0; tap < partitionSize; ++tap)
+            juce::FloatVectorOperations::addWithMultiply(wet, history + position + 1 + tap, head[tap], run);
+
+        juce::FloatVectorOperations::copy(history + position, history + partitionSize + position, run);
+
+        juce::FloatVectorOperations::multiply(runSamples, dryGain, run);
+        juce::FloatVectorOperations::addWithMultiply(runSamples, wet, wetGain, run);
+
+        // The partitioned tail runs once per full block
+        position += run;
+        done += run;
+        if (position == partitionSize)
+        {
+            if (e.numPartitions > 0)
+                processPartition(e, channel);
+            position = 0;
+        }
+    }
+}
+
+void ConvolutionStage::processPartition(Engine& e, int channel)
+{
+    constexpr int spectrumFloats = Engine::spectrumFloats;
+    auto& window = e.inputWindow[channel];
+
+    // Transform the previous and current block together (overlap-save)
+    std::fill(e.fftBuffer.begin(), e.fftBuffer.end(), 0.0f);
+    std::copy(window.begin(), window.end(), e.fftBuffer.begin());
+    e.fft.performRealOnlyForwardTransform(e.fftBuffer.data(), true);
+
+    // Newest input spectrum goes into the frequency-domain delay line
+    float* delayLine = e.delayLine[channel].data();
+    int& newest = e.delayLineIndex[channel];
+    std::copy(e.fftBuffer.begin(), e.fftBuffer.begin() + spectrumFloats,
+              delayLine + static_cast<size_t>(newest) * spectrumFloats);
+
+    // Multiply-accumulate every partition against the matching past input spectrum
+    float* acc = e.accumulator.data();
+    std::fill(acc, acc + spectrumFloats, 0.0f);
+    const float* spectra = e.tailSpectra[channel].data();
+
+    int slot = newest;
+    for (int partition = 0; partition < e.numPartitions; ++partition)
+    {
+        const float* x = delayLine + static_cast<size_t>(slot) * spectrumFloats;
+        const float* h = spectra + static_cast<size_t>(partition) * spectrumFloats;
+
+        for (int bin = 0; bin < spectrumFloats; bin += 2)
+        {
+            acc[bin]     += x[bin] * h[bin] - x[bin + 1] * h[bin + 1];
+            acc[bin + 1] += x[bin] * h[bin + 1] + x[bin + 1] * h[bin];
+        }
+
+        slot = (slot == 0 ? e.numPartitions : slot) - 1;
+    }
+
+    std::fill(e.fftBuffer.begin(), e.fftBuffer.end(), 0.0f);
+    std::copy(acc, acc + spectrumFloats, e.fftBuffer.begin());
+    e.fft.performRealOnlyInverseTransform(e.fftBuffer.data());
+
+    // The second half is the valid output; it plays while the next block is collected
+    std::copy(e.fftBuffer.begin() + partitionSize, e.fftBuffer.begin() + 2 * partitionSize, e.tailOutput[channel].begin());
+
+    // Slide the window and advance the delay line
+    std::copy(window.begin() + partitionSize, window.end(), window.begin());
+    newest = (newest + 1) % e.numPartitions;
+}
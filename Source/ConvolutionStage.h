@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    ConvolutionStage.h
+
+    Post-synth convolution for DUMUMUB wavetable synthesizer.
+    Uses the dropped audio file as an impulse response.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Convolution Stage - Zero-Latency Uniformly Partitioned Convolution
+ *
+ * The first partition of the impulse response runs as a direct-form FIR so
+ * the output has no added latency. The rest of the response runs as a
+ * uniformly partitioned overlap-save convolution whose one-block delay lines
+ * up exactly with the head.
+ *
+ * Partition spectra are prepared on a background thread and swapped in under
+ * a spin lock that the audio thread only ever try-locks. When disabled the
+ * stage returns before touching any of its state.
+ */
+class ConvolutionStage
+{
+public:
+    // Head length and tail partition size in samples
+    static constexpr int partitionSize = 256;
+    static constexpr double maximumImpulseSeconds = 4.0;
+
+    ConvolutionStage();
+    ~ConvolutionStage();
+
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled; }
+    void setMix(float newMix) { mix = juce::jlimit(0.0f, 1.0f, newMix); }
+    float getMix() const { return mix; }
+
+    // Background thread: resample, partition and transform an impulse, then swap it in
+    void loadImpulse(const juce::AudioBuffer<float>& impulse, double impulseSampleRate, double outputSampleRate);
+
+    // Background thread: free the partitions (the stage passes audio through dry until the next load)
+    void releaseImpulse();
+
+    // Audio thread: convolve the first two channels of the buffer in place
+    void process(juce::AudioBuffer<float>& buffer);
+
+private:
+    struct Engine;
+
+    void processChannel(Engine& engine, int channel, float* samples, int startPosition, int numSamples, float wetGain, float dryGain);
+    static void processPartition(Engine& engine, int channel);
+
+    std::unique_ptr<Engine> engine;
+    juce::SpinLock engineLock;
+
+    std::atomic<bool> enabled { false };
+    std::atomic<float> mix { 0.35f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionStage)
+};
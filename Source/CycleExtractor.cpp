@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    CycleExtractor.cpp
+
+    YIN pitch tracking and cycle resampling.
+
+  ==============================================================================
+*/
+
+#include "CycleExtractor.h"
+
+//==============================================================================
+int CycleExtractor::getRequiredLength(double sampleRate)
+{
+    const int maximumLag = static_cast<int>(std::ceil(sampleRate / minimumFrequency));
+    return maximumLag * 2 + 2;
+}
+
+float CycleExtractor::detectPeriod(const float* mono, int numSamples, double sampleRate)
+{
+    const int minimumLag = juce::jmax(2, static_cast<int>(sampleRate / maximumFrequency));
+    const int maximumLag = static_cast<int>(std::ceil(sampleRate / minimumFrequency));
+    const int window = numSamples - maximumLag - 1;
+
+    if (window < maximumLag)
+        return 0.0f;
+
+    // Ignore silence outright
+    float energy = 0.0f;
+    for (int i = 0; i < window; ++i)
+        energy += mono[i] * mono[i];
+    if (energy < 1.0e-6f * window)
+        return 0.0f;
+
+    difference.resize(static_cast<size_t>(maximumLag + 2));
+    correlate(mono, numSamples, window);
+
+    // Difference function, expanded as energy + delayed energy - 2 * correlation, and its
+    // cumulative-mean normalisation
+    difference[0] = 1.0f;
+    double delayedEnergy = energy;
+    float runningSum = 0.0f;
+
+    for (int lag = 1; lag <= maximumLag + 1; ++lag)
+    {
+        delayedEnergy += static_cast<double>(mono[lag + window - 1]) * mono[lag + window - 1]
+                       - static_cast<double>(mono[lag - 1]) * mono[lag - 1];
+
+        const float sum = juce::jmax(0.0f, static_cast<float>(energy + delayedEnergy - 2.0 * signalSpectrum[static_cast<size_t>(lag)]));
+
+        runningSum += sum;
+        difference[static_cast<size_t>(lag)] = runningSum > 0.0f ? sum * lag / runningSum : 1.0f;
+    }
+
+    // First dip under the threshold, followed down to its local minimum
+    const float threshold = 0.15f;
+    int lag = minimumLag;
+    while (lag <= maximumLag && difference[static_cast<size_t>(lag)] >= threshold)
+        ++lag;
+
+    if (lag > maximumLag)
+        return 0.0f;
+
+    while (lag < maximumLag && difference[static_cast<size_t>(lag + 1)] < difference[static_cast<size_t>(lag)])
+        ++lag;
+
+    // Parabolic refinement around the minimum
+    const float before = difference[static_cast<size_t>(lag - 1)];
+    const float at = difference[static_cast<size_t>(lag)];
+    const float after = difference[static_cast<size_t>(lag + 1)];
+    const float denominator = before - 2.0f * at + after;
+    const float offset = denominator > 0.0f ? 0.5f * (before - after) / denominator : 0.0f;
+
+    return static_cast<float>(lag) + juce::jlimit(-0.5f, 0.5f, offset);
+}
+
+void CycleExtractor::correlate(const float* mono, int numSamples, int window)
+{
+    // One transform covers the whole signal, so lags up to numSamples - window never wrap
+    int order = 1;
+    while ((1 << order) < numSamples)
+        ++order;
+
+    const int size = 1 << order;
+    if (fft == nullptr || fft->getSize() != size)
+    {
+        fft = std::make_unique<juce::dsp::FFT>(order);
+        windowSpectrum.assign(static_cast<size_t>(size * 2), 0.0f);
+        signalSpectrum.assign(static_cast<size_t>(size * 2), 0.0f);
+    }
+
+    std::fill(windowSpectrum.begin(), windowSpectrum.end(), 0.0f);
+    std::fill(signalSpectrum.begin(), signalSpectrum.end(), 0.0f);
+    std::copy(mono, mono + window, windowSpectrum.begin());
+    std::copy(mono, mono + numSamples, signalSpectrum.begin());
+
+    fft->performRealOnlyForwardTransform(windowSpectrum.data(), true);
+    fft->performRealOnlyForwardTransform(signalSpectrum.data(), true);
+
+    // conj(window) * signal transforms back to sum(mono[i] * mono[i + lag]) over the window
+    for (int bin = 0; bin <= size / 2; ++bin)
+    {
+        const float windowRe = windowSpectrum[static_cast<size_t>(bin * 2)];
+        const float windowIm = windowSpectrum[static_cast<size_t>(bin * 2 + 1)];
+        const float signalRe = signalSpectrum[static_cast<size_t>(bin * 2)];
+        const float signalIm = signalSpectrum[static_cast<size_t>(bin * 2 + 1)];
+        signalSpectrum[static_cast<size_t>(bin * 2)] = windowRe * signalRe + windowIm * signalIm;
+        signalSpectrum[static_cast<size_t>(bin * 2 + 1)] = windowRe * signalIm - windowIm * signalRe;
+    }
+
+    fft->performRealOnlyInverseTransform(signalSpectrum.data());
+}
+
+bool CycleExtractor::extractCycle(const float* left, const float* right, int numSamples, float period,
+                                  std::array<float, tableSize>& tableL, std::array<float, tableSize>& tableR) const
+{
+    const int wholePeriod = static_cast<int>(std::ceil(period));
+    if (period < 2.0f || numSamples < wholePeriod * 2 + 2)
+        return false;
+
+    // Search backwards from the end for a rising zero crossing with a full period after it
+    int start = -1;
+    for (int i = numSamples - wholePeriod - 2; i > numSamples - 2 * wholePeriod - 2 && i >= 0; --i)
+    {
+        const float a = left[i] + right[i];
+        const float b = left[i + 1] + right[i + 1];
+        if (a <= 0.0f && b > 0.0f)
+        {
+            start = i;
+            break;
+        }
+    }
+
+    if (start < 0)
+        start = numSamples - wholePeriod - 2;
+
+    // Refine the crossing to a fractional position on the mid signal
+    const float a = left[start] + right[start];
+    const float b = left[start + 1] + right[start + 1];
+    const double fractionalStart = start + (b != a ? juce::jlimit(0.0f, 1.0f, -a / (b - a)) : 0.0f);
+
+    resampleCycle(left, fractionalStart, period, tableL);
+    resampleCycle(right, fractionalStart, period, tableR);
+    return true;
+}
+
+void CycleExtractor::resampleCycle(const float* source, double start, double period, std::array<float, tableSize>& table)
+{
+    // Linear interpolation at tableSize + 1 points so the end-point drift can be measured
+    auto sampleAt = [source](double position)
+    {
+        const int index = static_cast<int>(position);
+        const float fraction = static_cast<float>(position - index);
+        return source[index] + fraction * (source[index + 1] - source[index]);
+    };
+
+    const double step = period / tableSize;
+    for (int i = 0; i < tableSize; ++i)
+        table[i] = sampleAt(start + i * step);
+
+    // Remove the drift between the two ends so the cycle loops without a step
+    const float drift = sampleAt(start + period) - table[0];
+    float mean = 0.0f;
+    for (int i = 0; i < tableSize; ++i)
+    {
+        table[i] -= drift * static_cast<float>(i) / tableSize;
+        mean += table[i];
+    }
+    mean /= tableSize;
+
+    for (auto& sample : table)
+        sample -= mean;
+
+    normalise(table);
+}
+
+void CycleExtractor::normalise(std::array<float, tableSize>& table)
+{
+    float peak = 0.0f;
+    for (auto sample : table)
+        peak = juce::jmax(peak, std::abs(sample));
+
+    if (peak > 0.0f)
+        for (auto& sample : table)
+            sample /= peak;
+}
+
+bool CycleExtractor::extractAveragedCycle(const float* left, const float* right, int numSamples, float period, int cycles,
+                                          std::array<float, tableSize>& tableL, std::array<float, tableSize>& tableR) const
+{
+    const int shortestEnd = static_cast<int>(std::ceil(period)) * 2 + 2;
+    if (cycles < 1 || numSamples < shortestEnd)
+        return false;
+
+    std::array<float, tableSize> cycleL, cycleR;
+    tableL.fill(0.0f);
+    tableR.fill(0.0f);
+    int extracted = 0;
+
+    // Each cycle is aligned on its own rising zero crossing, so they sum in phase
+    for (int i = 0; i < cycles; ++i)
+    {
+        const int end = cycles == 1 ? numSamples : shortestEnd + (numSamples - shortestEnd) * i / (cycles - 1);
+        if (!extractCycle(left, right, end, period, cycleL, cycleR))
+            continue;
+
+        juce::FloatVectorOperations::add(tableL.data(), cycleL.data(), tableSize);
+        juce::FloatVectorOperations::add(tableR.data(), cycleR.data(), tableSize);
+        ++extracted;
+    }
+
+    if (extracted == 0)
+        return false;
+
+    normalise(tableL);
+    normalise(tableR);
+    return true;
+}
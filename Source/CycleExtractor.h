@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    CycleExtractor.h
+
+    Pitch tracking and single-cycle extraction for DUMUMUB wavetable synthesizer.
+    Turns a stretch of pitched audio into a 1024-sample wavetable.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Cycle Extractor - YIN Pitch Tracking and Cycle Resampling
+ *
+ * detectPeriod() finds the fundamental period of a mono signal with the YIN
+ * cumulative-mean-normalised difference and parabolic refinement, returning
+ * 0 for unvoiced input. The difference function's cross term comes from one
+ * FFT correlation rather than a sum per lag. extractCycle() takes one period from a stereo signal,
+ * starting at a rising zero crossing, removes DC and end-point drift so the
+ * table loops cleanly, and resamples it to 1024 points.
+ *
+ * Scratch storage and the FFT plan are owned by the extractor, so repeated
+ * analysis at one rate on a worker thread does not allocate.
+ */
+class CycleExtractor
+{
+public:
+    static constexpr int tableSize = 1024;
+    static constexpr double minimumFrequency = 40.0;
+    static constexpr double maximumFrequency = 2000.0;
+
+    CycleExtractor() = default;
+
+    // Samples detectPeriod() needs at this rate (analysis window plus the longest lag)
+    static int getRequiredLength(double sampleRate);
+
+    // Fundamental period in samples (fractional), or 0 if no clear pitch
+    float detectPeriod(const float* mono, int numSamples, double sampleRate);
+
+    // Extract the last full cycle of the given period; false if there is not enough signal
+    bool extractCycle(const float* left, const float* right, int numSamples, float period,
+                      std::array<float, tableSize>& tableL, std::array<float, tableSize>& tableR) const;
+
+    // Average cycles extracted at evenly spaced points through the signal into one table
+    bool extractAveragedCycle(const float* left, const float* right, int numSamples, float period, int cycles,
+                              std::array<float, tableSize>& tableL, std::array<float, tableSize>& tableR) const;
+
+private:
+    static void normalise(std::array<float, tableSize>& table);
+    static void resampleCycle(const float* source, double start, double period, std::array<float, tableSize>& table);
+
+    // Leaves the correlation of the first window samples with the whole signal, by lag, in signalSpectrum
+    void correlate(const float* mono, int numSamples, int window);
+
+    std::vector<float> difference;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> windowSpectrum, signalSpectrum;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CycleExtractor)
+};
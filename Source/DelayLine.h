@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    DelayLine.h
+
+    Circular delay buffer shared by the DUMUMUB effects.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+/**
+ * Delay Line - Power-of-Two Circular Buffer
+ *
+ * Storage is allocated once in allocate() (from prepareToPlay) and never
+ * resized on the audio thread. Single-sample access covers modulated and
+ * feedback paths; block access copies in at most two contiguous runs so
+ * fixed delays can use vectorised operations.
+ */
+class DelayLine
+{
+public:
+    DelayLine() = default;
+
+    // Allocate room for at least maximumDelay samples of history and clear it
+    void allocate(int maximumDelay)
+    {
+        int size = 1;
+        while (size < maximumDelay + 1)
+            size <<= 1;
+
+        buffer.assign(static_cast<size_t>(size), 0.0f);
+        mask = size - 1;
+        writeIndex = 0;
+    }
+
+    void clear()
+    {
+        std::fill(buffer.begin(), buffer.end(), 0.0f);
+    }
+
+    int getMaximumDelay() const { return mask; }
+
+    // Sample written `delay` samples ago (delay 1 = previous sample)
+    float read(int delay) const
+    {
+        return buffer[static_cast<size_t>((writeIndex - delay) & mask)];
+    }
+
+    // Linearly interpolated read for modulated delays
+    float readFractional(float delay) const
+    {
+        const int whole = static_cast<int>(delay);
+        const float fraction = delay - static_cast<float>(whole);
+        const float a = read(whole);
+        const float b = read(whole + 1);
+        return a + fraction * (b - a);
+    }
+
+    void push(float sample)
+    {
+        buffer[static_cast<size_t>(writeIndex)] = sample;
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    // Copy numSamples starting `delay` samples back. numSamples must not exceed delay.
+    void readBlock(float* destination, int delay, int numSamples) const
+    {
+        const int start = (writeIndex - delay) & mask;
+        const int firstRun = juce::jmin(numSamples, mask + 1 - start);
+
+        juce::FloatVectorOperations::copy(destination, buffer.data() + start, firstRun);
+        if (firstRun < numSamples)
+            juce::FloatVectorOperations::copy(destination + firstRun, buffer.data(), numSamples - firstRun);
+    }
+
+    void writeBlock(const float* source, int numSamples)
+    {
+        const int firstRun = juce::jmin(numSamples, mask + 1 - writeIndex);
+
+        juce::FloatVectorOperations::copy(buffer.data() + writeIndex, source, firstRun);
+        if (firstRun < numSamples)
+            juce::FloatVectorOperations::copy(buffer.data(), source + firstRun, numSamples - firstRun);
+
+        writeIndex = (writeIndex + numSamples) & mask;
+    }
+
+private:
+    std::vector<float> buffer { 0.0f };
+    int mask = 0;
+    int writeIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayLine)
+};
@@ -0,0 +1,386 @@
+/*
+  ==============================================================================
+
+    EffectsChain.cpp
+
+    Chorus, stereo delay and plate reverb implementations.
+
+  ==============================================================================
+*/
+
+#include "EffectsChain.h"
+
+//==============================================================================
+// Chorus
+void ChorusEffect::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    const int maximumDelay = static_cast<int>((baseDelaySeconds + 0.006) * sampleRate) + 2;
+    for (auto& line : lines)
+        line.allocate(maximumDelay);
+
+    lfoPhase = 0.0f;
+}
+
+void ChorusEffect::clear()
+{
+    for (auto& line : lines)
+        line.clear();
+}
+
+void ChorusEffect::process(float* left, float* right, int numSamples)
+{
+    const float wetGain = mix;
+    const float dryGain = 1.0f - wetGain;
+    const float baseDelay = static_cast<float>(baseDelaySeconds * currentSampleRate);
+    const float depthSamples = depth * 0.001f * static_cast<float>(currentSampleRate);
+    const float phaseStep = juce::MathConstants<float>::twoPi * rate * controlInterval / static_cast<float>(currentSampleRate);
+
+    float* channels[2] = { left, right };
+
+    // Left and right taps sit a quarter cycle apart for width
+    auto delayAt = [&](float phase, int channel)
+    {
+        return baseDelay + depthSamples * std::sin(phase + channel * juce::MathConstants<float>::halfPi);
+    };
+
+    for (int start = 0; start < numSamples; start += controlInterval)
+    {
+        const int count = juce::jmin(controlInterval, numSamples - start);
+        const float nextPhase = lfoPhase + phaseStep;
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto& line = lines[channel];
+            float* samples = channels[channel] + start;
+
+            float delay = delayAt(lfoPhase, channel);
+            const float delayStep = (delayAt(nextPhase, channel) - delay) / controlInterval;
+
+            for (int i = 0; i < count; ++i)
+            {
+                const float input = samples[i];
+                line.push(input);
+                samples[i] = input * dryGain + line.readFractional(delay) * wetGain;
+                delay += delayStep;
+            }
+        }
+
+        lfoPhase = nextPhase >= juce::MathConstants<float>::twoPi ? nextPhase - juce::MathConstants<float>::twoPi : nextPhase;
+    }
+}
+
+//==============================================================================
+// Stereo Delay
+void StereoDelayEffect::prepare(double sampleRate, int maximumBlockSize)
+{
+    currentSampleRate = sampleRate;
+
+    const int maximumDelay = static_cast<int>(maximumDelayMilliseconds * 0.001 * sampleRate) + 1;
+    for (auto& line : lines)
+        line.allocate(maximumDelay);
+
+    delayed.assign(static_cast<size_t>(juce::jmax(32, maximumBlockSize)), 0.0f);
+    feed.assign(delayed.size(), 0.0f);
+}
+
+void StereoDelayEffect::clear()
+{
+    for (auto& line : lines)
+        line.clear();
+}
+
+void StereoDelayEffect::process(float* left, float* right, int numSamples)
+{
+    const float feedbackGain = feedback;
+    const float wetGain = mix;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const int delaySamples = juce::jlimit(1, lines[channel].getMaximumDelay(),
+                                              static_cast<int>(times[channel] * 0.001f * currentSampleRate));
+        processChannel(lines[channel], channel == 0 ? left : right, numSamples, delaySamples, feedbackGain, wetGain);
+    }
+}
+
+void StereoDelayEffect::processChannel(DelayLine& line, float* samples, int numSamples, int delaySamples, float feedbackGain, float wetGain)
+{
+    // Runs no longer than the delay only ever read history written before the run
+    const int runLength = juce::jmin(delaySamples, static_cast<int>(delayed.size()));
+
+    for (int start = 0; start < numSamples; start += runLength)
+    {
+        const int count = juce::jmin(runLength, numSamples - start);
+        float* block = samples + start;
+
+        line.readBlock(delayed.data(), delaySamples, count);
+
+        // Line input is dry plus feedback; output is dry plus the wet tap
+        juce::FloatVectorOperations::copy(feed.data(), block, count);
+        juce::FloatVectorOperations::addWithMultiply(feed.data(), delayed.data(), feedbackGain, count);
+        line.writeBlock(feed.data(), count);
+
+        juce::FloatVectorOperations::addWithMultiply(block, delayed.data(), wetGain, count);
+    }
+}
+
+//==============================================================================
+// Plate Reverb
+namespace
+{
+    constexpr double referenceRate = 29761.0;
+
+    constexpr int referenceLengths[] = { 142, 107, 379, 277,
+                                         672, 4453, 1800, 3720,
+                                         908, 4217, 2656, 3163 };
+
+    // Output tap offsets: seven for the left channel, then seven for the right
+    constexpr int referenceTaps[] = { 266, 2974, 1913, 1996, 1990, 187, 1066,
+                                      353, 3627, 1228, 2673, 2111, 335, 121 };
+
+    constexpr float referenceExcursion = 16.0f;
+}
+
+int PlateReverb::scaled(int referenceLength) const
+{
+    return juce::jmax(1, juce::roundToInt(referenceLength * currentSampleRate / referenceRate));
+}
+
+void PlateReverb::prepare(double sampleRate, int maximumBlockSize)
+{
+    currentSampleRate = sampleRate;
+    modulationExcursion = referenceExcursion * static_cast<float>(sampleRate / referenceRate);
+
+    for (int i = 0; i < numLines; ++i)
+    {
+        lengths[i] = scaled(referenceLengths[i]);
+
+        // Modulated allpasses need room for the excursion
+        const bool modulated = (i == tankAllpassA1 || i == tankAllpassB1);
+        lines[i].allocate(lengths[i] + (modulated ? static_cast<int>(modulationExcursion) + 2 : 0));
+    }
+
+    for (size_t i = 0; i < taps.size(); ++i)
+        taps[i] = scaled(referenceTaps[i]);
+
+    predelayLine.allocate(static_cast<int>(0.2 * sampleRate) + 2);
+
+    // ~1 Hz tank modulation, advanced as a rotating phasor
+    lfoStep = juce::MathConstants<float>::twoPi * 1.0f / static_cast<float>(sampleRate);
+    lfoSin = 0.0f;
+    lfoCos = 1.0f;
+
+    const size_t blockSize = static_cast<size_t>(juce::jmax(32, maximumBlockSize));
+    monoInput.assign(blockSize, 0.0f);
+    wetLeft.assign(blockSize, 0.0f);
+    wetRight.assign(blockSize, 0.0f);
+
+    clear();
+}
+
+void PlateReverb::clear()
+{
+    for (auto& line : lines)
+        line.clear();
+    predelayLine.clear();
+
+    bandwidthState = dampingStateA = dampingStateB = 0.0f;
+    tankFeedA = tankFeedB = 0.0f;
+}
+
+float PlateReverb::allpass(Line line, float input, float coefficient)
+{
+    const float delayed = lines[line].read(lengths[line]);
+    const float v = input - coefficient * delayed;
+    lines[line].push(v);
+    return delayed + coefficient * v;
+}
+
+void PlateReverb::process(float* left, float* right, int numSamples)
+{
+    const float decay = 0.2f + 0.78f * size;
+    const float dampingCoefficient = 0.9f * damping;
+    const float bandwidth = 0.9995f;
+    const float wetGain = mix * 0.6f;
+    const int predelaySamples = juce::jlimit(1, predelayLine.getMaximumDelay(),
+                                             static_cast<int>(predelay * 0.001f * currentSampleRate) + 1);
+
+    for (int start = 0; start < numSamples; start += static_cast<int>(monoInput.size()))
+    {
+        const int count = juce::jmin(static_cast<int>(monoInput.size()), numSamples - start);
+
+        // Mono send
+        juce::FloatVectorOperations::add(monoInput.data(), left + start, right + start, count);
+        juce::FloatVectorOperations::multiply(monoInput.data(), 0.5f, count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            // Predelay and input bandwidth
+            float x = predelayLine.read(predelaySamples);
+            predelayLine.push(monoInput[static_cast<size_t>(i)]);
+            bandwidthState += bandwidth * (x - bandwidthState);
+            x = bandwidthState;
+
+            // Input diffusion
+            x = allpass(inputDiffuser1, x, 0.75f);
+            x = allpass(inputDiffuser2, x, 0.75f);
+            x = allpass(inputDiffuser3, x, 0.625f);
+            x = allpass(inputDiffuser4, x, 0.625f);
+
+            // Slow modulation of the first tank allpass in each half
+            lfoSin += lfoStep * lfoCos;
+            lfoCos -= lfoStep * lfoSin;
+            const float modulationA = modulationExcursion * lfoSin;
+            const float modulationB = modulationExcursion * lfoCos;
+
+            // Tank half A
+            {
+                auto& ap = lines[tankAllpassA1];
+                const float delayedA = ap.readFractional(lengths[tankAllpassA1] + modulationA);
+                const float v = (x + tankFeedB) + 0.7f * delayedA;
+                ap.push(v);
+                float a = delayedA - 0.7f * v;
+
+                const float fromDelay = lines[tankDelayA1].read(lengths[tankDelayA1]);
+                lines[tankDelayA1].push(a);
+                dampingStateA = fromDelay + dampingCoefficient * (dampingStateA - fromDelay);
+                a = allpass(tankAllpassA2, dampingStateA * decay, 0.5f);
+
+                tankFeedA = lines[tankDelayA2].read(lengths[tankDelayA2]) * decay;
+                lines[tankDelayA2].push(a);
+            }
+
+            // Tank half B
+            {
+                auto& ap = lines[tankAllpassB1];
+                const float delayedB = ap.readFractional(lengths[tankAllpassB1] + modulationB);
+                const float v = (x + tankFeedA) + 0.7f * delayedB;
+                ap.push(v);
+                float b = delayedB - 0.7f * v;
+
+                const float fromDelay = lines[tankDelayB1].read(lengths[tankDelayB1]);
+                lines[tankDelayB1].push(b);
+                dampingStateB = fromDelay + dampingCoefficient * (dampingStateB - fromDelay);
+                b = allpass(tankAllpassB2, dampingStateB * decay, 0.5f);
+
+                tankFeedB = lines[tankDelayB2].read(lengths[tankDelayB2]) * decay;
+                lines[tankDelayB2].push(b);
+            }
+
+            // Output taps
+            wetLeft[static_cast<size_t>(i)] = lines[tankDelayB1].read(taps[0])
+                                            + lines[tankDelayB1].read(taps[1])
+                                            - lines[tankAllpassB2].read(taps[2])
+                                            + lines[tankDelayB2].read(taps[3])
+                                            - lines[tankDelayA1].read(taps[4])
+                                            - lines[tankAllpassA2].read(taps[5])
+                                            - lines[tankDelayA2].read(taps[6]);
+
+            wetRight[static_cast<size_t>(i)] = lines[tankDelayA1].read(taps[7])
+                                             + lines[tankDelayA1].read(taps[8])
+                                             - lines[tankAllpassA2].read(taps[9])
+                                             + lines[tankDelayA2].read(taps[10])
+                                             - lines[tankDelayB1].read(taps[11])
+                                             - lines[tankAllpassB2].read(taps[12])
+                                             - lines[tankDelayB2].read(taps[13]);
+        }
+
+        // Dry is kept at full level; the plate is added as a send
+        juce::FloatVectorOperations::addWithMultiply(left + start, wetLeft.data(), wetGain, count);
+        juce::FloatVectorOperations::addWithMultiply(right + start, wetRight.data(), wetGain, count);
+    }
+}
+
+//==============================================================================
+// Chain
+void EffectsChain::prepare(double sampleRate, int maximumBlockSize)
+{
+    chorusEffect.prepare(sampleRate);
+    delayEffect.prepare(sampleRate, maximumBlockSize);
+    reverbEffect.prepare(sampleRate, maximumBlockSize);
+}
+
+void EffectsChain::process(juce::AudioBuffer<float>& buffer)
+{
+    if (buffer.getNumChannels() < 2)
+        return;
+
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getWritePointer(1);
+    const int numSamples = buffer.getNumSamples();
+
+    for (int effect = 0; effect < numEffects; ++effect)
+    {
+        const bool isOn = enabled[effect];
+        const bool switchedOn = isOn && !wasEnabled[effect];
+        wasEnabled[effect] = isOn;
+
+        if (!isOn)
+            continue;
+
+        switch (effect)
+        {
+            case chorus:
+                if (switchedOn) chorusEffect.clear();
+                chorusEffect.process(left, right, numSamples);
+                break;
+            case delay:
+                if (switchedOn) delayEffect.clear();
+                delayEffect.process(left, right, numSamples);
+                break;
+            case reverb:
+                if (switchedOn) reverbEffect.clear();
+                reverbEffect.process(left, right, numSamples);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void EffectsChain::writeState(juce::XmlElement& parent) const
+{
+    auto* xml = parent.createNewChildElement("Effects");
+
+    xml->setAttribute("chorusEnabled", enabled[chorus].load());
+    xml->setAttribute("chorusRate", chorusEffect.getRate());
+    xml->setAttribute("chorusDepth", chorusEffect.getDepth());
+    xml->setAttribute("chorusMix", chorusEffect.getMix());
+
+    xml->setAttribute("delayEnabled", enabled[delay].load());
+    xml->setAttribute("delayTimeL", delayEffect.getTime(0));
+    xml->setAttribute("delayTimeR", delayEffect.getTime(1));
+    xml->setAttribute("delayFeedback", delayEffect.getFeedback());
+    xml->setAttribute("delayMix", delayEffect.getMix());
+
+    xml->setAttribute("reverbEnabled", enabled[reverb].load());
+    xml->setAttribute("reverbSize", reverbEffect.getSize());
+    xml->setAttribute("reverbDamping", reverbEffect.getDamping());
+    xml->setAttribute("reverbPredelay", reverbEffect.getPredelay());
+    xml->setAttribute("reverbMix", reverbEffect.getMix());
+}
+
+void EffectsChain::readState(const juce::XmlElement& parent)
+{
+    auto* xml = parent.getChildByName("Effects");
+    if (xml == nullptr)
+        return;
+
+    setEnabled(chorus, xml->getBoolAttribute("chorusEnabled", false));
+    chorusEffect.setRate(xml->getDoubleAttribute("chorusRate", 0.8));
+    chorusEffect.setDepth(xml->getDoubleAttribute("chorusDepth", 2.5));
+    chorusEffect.setMix(xml->getDoubleAttribute("chorusMix", 0.5));
+
+    setEnabled(delay, xml->getBoolAttribute("delayEnabled", false));
+    delayEffect.setTime(0, xml->getDoubleAttribute("delayTimeL", 375.0));
+    delayEffect.setTime(1, xml->getDoubleAttribute("delayTimeR", 500.0));
+    delayEffect.setFeedback(xml->getDoubleAttribute("delayFeedback", 0.35));
+    delayEffect.setMix(xml->getDoubleAttribute("delayMix", 0.3));
+
+    setEnabled(reverb, xml->getBoolAttribute("reverbEnabled", false));
+    reverbEffect.setSize(xml->getDoubleAttribute("reverbSize", 0.5));
+    reverbEffect.setDamping(xml->getDoubleAttribute("reverbDamping", 0.3));
+    reverbEffect.setPredelay(xml->getDoubleAttribute("reverbPredelay", 10.0));
+    reverbEffect.setMix(xml->getDoubleAttribute("reverbMix", 0.25));
+}
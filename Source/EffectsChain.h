@@ -0,0 +1,194 @@
+/*
+  ==============================================================================
+
+    EffectsChain.h
+
+    Built-in effects bus for DUMUMUB wavetable synthesizer.
+    Chorus, stereo delay and plate reverb, processed in place on the synth output.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayLine.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Chorus - Two quadrature-modulated delay taps, one per channel.
+ * The LFO is evaluated once per control step and the delay ramped in between.
+ */
+class ChorusEffect
+{
+public:
+    ChorusEffect() = default;
+
+    void prepare(double sampleRate);
+    void process(float* left, float* right, int numSamples);
+    void clear();
+
+    void setRate(float hz) { rate = juce::jlimit(0.05f, 10.0f, hz); }
+    void setDepth(float milliseconds) { depth = juce::jlimit(0.0f, 5.0f, milliseconds); }
+    void setMix(float newMix) { mix = juce::jlimit(0.0f, 1.0f, newMix); }
+    float getRate() const { return rate; }
+    float getDepth() const { return depth; }
+    float getMix() const { return mix; }
+
+private:
+    static constexpr int controlInterval = 32;
+    static constexpr double baseDelaySeconds = 0.007;
+
+    double currentSampleRate = 44100.0;
+    std::array<DelayLine, 2> lines;
+    float lfoPhase = 0.0f;
+
+    std::atomic<float> rate { 0.8f };
+    std::atomic<float> depth { 2.5f };
+    std::atomic<float> mix { 0.5f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusEffect)
+};
+
+//==============================================================================
+/**
+ * Stereo Delay - Independent left/right times with feedback.
+ * Delay times are fixed within a block, so each channel runs in contiguous
+ * runs no longer than its delay and every inner loop is a vector operation.
+ */
+class StereoDelayEffect
+{
+public:
+    static constexpr float maximumDelayMilliseconds = 2000.0f;
+
+    StereoDelayEffect() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void process(float* left, float* right, int numSamples);
+    void clear();
+
+    void setTime(int channel, float milliseconds) { times[channel & 1] = juce::jlimit(10.0f, maximumDelayMilliseconds, milliseconds); }
+    void setFeedback(float newFeedback) { feedback = juce::jlimit(0.0f, 0.95f, newFeedback); }
+    void setMix(float newMix) { mix = juce::jlimit(0.0f, 1.0f, newMix); }
+    float getTime(int channel) const { return times[channel & 1]; }
+    float getFeedback() const { return feedback; }
+    float getMix() const { return mix; }
+
+private:
+    void processChannel(DelayLine& line, float* samples, int numSamples, int delaySamples, float feedbackGain, float wetGain);
+
+    double currentSampleRate = 44100.0;
+    std::array<DelayLine, 2> lines;
+    std::vector<float> delayed;
+    std::vector<float> feed;
+
+    std::array<std::atomic<float>, 2> times { { { 375.0f }, { 500.0f } } };
+    std::atomic<float> feedback { 0.35f };
+    std::atomic<float> mix { 0.3f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StereoDelayEffect)
+};
+
+//==============================================================================
+/**
+ * Plate Reverb - Dattorro figure-eight tank.
+ * Mono input through predelay, bandwidth filter and four input diffusers into
+ * two cross-fed tank halves; stereo output from the standard tap set.
+ */
+class PlateReverb
+{
+public:
+    PlateReverb() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void process(float* left, float* right, int numSamples);
+    void clear();
+
+    void setSize(float newSize) { size = juce::jlimit(0.0f, 1.0f, newSize); }
+    void setDamping(float newDamping) { damping = juce::jlimit(0.0f, 1.0f, newDamping); }
+    void setPredelay(float milliseconds) { predelay = juce::jlimit(0.0f, 200.0f, milliseconds); }
+    void setMix(float newMix) { mix = juce::jlimit(0.0f, 1.0f, newMix); }
+    float getSize() const { return size; }
+    float getDamping() const { return damping; }
+    float getPredelay() const { return predelay; }
+    float getMix() const { return mix; }
+
+private:
+    // Delay lengths from the original design, at its 29761 Hz reference rate
+    enum Line { inputDiffuser1 = 0, inputDiffuser2, inputDiffuser3, inputDiffuser4,
+                tankAllpassA1, tankDelayA1, tankAllpassA2, tankDelayA2,
+                tankAllpassB1, tankDelayB1, tankAllpassB2, tankDelayB2, numLines };
+
+    int scaled(int referenceLength) const;
+    float allpass(Line line, float input, float coefficient);
+
+    double currentSampleRate = 44100.0;
+    std::array<DelayLine, numLines> lines;
+    std::array<int, numLines> lengths;
+    DelayLine predelayLine;
+    std::array<int, 14> taps;
+    float modulationExcursion = 0.0f;
+
+    // Filter and tank state
+    float bandwidthState = 0.0f;
+    float dampingStateA = 0.0f;
+    float dampingStateB = 0.0f;
+    float tankFeedA = 0.0f;
+    float tankFeedB = 0.0f;
+    float lfoSin = 0.0f;
+    float lfoCos = 1.0f;
+    float lfoStep = 0.0f;
+
+    std::vector<float> monoInput;
+    std::vector<float> wetLeft;
+    std::vector<float> wetRight;
+
+    std::atomic<float> size { 0.5f };
+    std::atomic<float> damping { 0.3f };
+    std::atomic<float> predelay { 10.0f };
+    std::atomic<float> mix { 0.25f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PlateReverb)
+};
+
+//==============================================================================
+/**
+ * Effects Chain - Chorus -> Delay -> Reverb, in place on the synth buffer
+ *
+ * All storage is allocated in prepare(). A disabled effect is skipped without
+ * touching its state; when it is switched back on its lines are cleared first
+ * so no stale tail plays out.
+ */
+class EffectsChain
+{
+public:
+    enum Effect { chorus = 0, delay, reverb, numEffects };
+
+    EffectsChain() = default;
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void process(juce::AudioBuffer<float>& buffer);
+
+    void setEnabled(Effect effect, bool shouldBeEnabled) { enabled[effect] = shouldBeEnabled; }
+    bool isEnabled(Effect effect) const { return enabled[effect]; }
+
+    ChorusEffect& getChorus() { return chorusEffect; }
+    StereoDelayEffect& getDelay() { return delayEffect; }
+    PlateReverb& getReverb() { return reverbEffect; }
+
+    // State persistence as an "Effects" child element
+    void writeState(juce::XmlElement& parent) const;
+    void readState(const juce::XmlElement& parent);
+
+private:
+    ChorusEffect chorusEffect;
+    StereoDelayEffect delayEffect;
+    PlateReverb reverbEffect;
+
+    std::array<std::atomic<bool>, numEffects> enabled { { { false }, { false }, { false } } };
+    std::array<bool, numEffects> wasEnabled { { false, false, false } };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EffectsChain)
+};
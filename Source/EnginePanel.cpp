@@ -0,0 +1,278 @@
+/*
+  ==============================================================================
+
+    EnginePanel.cpp
+
+    Engine panel rows, parameter attachments and column layout.
+
+  ==============================================================================
+*/
+
+#include "EnginePanel.h"
+
+//==============================================================================
+EnginePanel::EnginePanel(DUMUMUB003AudioProcessor& p) : audioProcessor(p)
+{
+    setOpaque(true);
+
+    addSection("OSCILLATOR");
+    addChoice("oscillatorMode");
+    addSlider("grainPosition");
+    addSlider("grainSize");
+    addSlider("grainDensity");
+    addSlider("grainSpray");
+    addSlider("grainPitch");
+    addSlider("additiveTilt");
+    addSlider("additiveOddEven");
+    addSlider("additiveStretch");
+
+    addSection("OPERATOR");
+    addChoice("operatorMode");
+    addSlider("operatorRatio");
+    addSlider("operatorIndex");
+
+    addSection("LAYERS");
+    addSlider("subLevel");
+    addChoice("subOctaves");
+    addSlider("noiseLevel");
+    addChoice("noiseColour");
+
+    juce::StringArray partNames;
+    for (int part = 1; part < DUMUMUB003AudioProcessor::numParts; ++part)
+        partNames.add("Channel " + juce::String(part + 1));
+
+    addSection("PARTS");
+    addToggle("multiTimbral");
+    addPicker("Part", partNames, selectedPart);   // Part n plays MIDI channel n + 1
+    addAction("STORE PATCH", [this] { audioProcessor.storePatchToPart(selectedPart + 1); });
+    addAction("RECALL PATCH", [this]
+    {
+        audioProcessor.recallPartToEditor(selectedPart + 1);
+        if (onPatchChanged)
+            onPatchChanged();
+    });
+
+    addSection("EXPRESSION");
+    addToggle("mpeEnabled");
+    addChoice("mpeZone");
+    addSlider("pitchBendRange");
+    addSlider("mpeNoteBendRange");
+
+    juce::StringArray setNames, zoneNames;
+    for (int set = 0; set < WavetableZoneMap::numSets; ++set)
+        setNames.add("Set " + juce::String(set + 1));
+    for (int zone = 0; zone < WavetableZoneMap::maxZonesPerSet; ++zone)
+        zoneNames.add("Zone " + juce::String(zone + 1));
+
+    // New zones capture the editor tables for the chosen key and velocity range
+    addSection("ZONES");
+    addToggle("keyswitchesEnabled");
+    addSlider("keyswitchBase");
+    addPicker("Slot Set", setNames, selectedZoneSet);
+    addValue("Low Key", 0, 127, zoneRange.lowKey);
+    addValue("High Key", 0, 127, zoneRange.highKey);
+    addValue("Low Velocity", 1, 127, zoneRange.lowVelocity);
+    addValue("High Velocity", 1, 127, zoneRange.highVelocity);
+    addAction("ADD ZONE", [this] { audioProcessor.addZoneFromEditor(selectedZoneSet, zoneRange); });
+    addPicker("Zone", zoneNames, selectedZone);
+    addAction("UPDATE ZONE", [this] { audioProcessor.updateZoneFromEditor(selectedZoneSet, selectedZone); });
+    addAction("CLEAR SET", [this] { audioProcessor.clearZoneSet(selectedZoneSet); });
+
+    // Capture the current left and right tables as the morph's ends, then sweep between them
+    addSection("MORPH");
+    addAction("MORPH LEFT TO RIGHT", [this] { audioProcessor.morphBetweenChannels(); });
+    addSlider("morphPosition");
+
+    addSection("LIVE CAPTURE");
+    addToggle("liveCaptureEnabled");
+
+    // Renders whatever is held on the keyboard; the result reaches the tables via the processor timer
+    addSection("BOUNCE");
+    addAction("BOUNCE HELD CHORD", [this] { audioProcessor.bounceToTable(); });
+
+    addSection("CONVOLUTION");
+    addToggle("convolutionEnabled");
+    addSlider("convolutionMix");
+
+    addSection("CHORUS");
+    addToggle("chorusEnabled");
+    for (auto id : { "chorusRate", "chorusDepth", "chorusMix" })
+        addSlider(id);
+
+    addSection("DELAY");
+    addToggle("delayEnabled");
+    for (auto id : { "delayTimeLeft", "delayTimeRight", "delayFeedback", "delayMix" })
+        addSlider(id);
+
+    addSection("REVERB");
+    addToggle("reverbEnabled");
+    for (auto id : { "reverbSize", "reverbDamping", "reverbPredelay", "reverbMix" })
+        addSlider(id);
+
+    addSection("OUTPUT");
+    addToggle("limiterEnabled");
+    addSlider("limiterCeiling");
+    addSlider("limiterRelease");
+    addToggle("softClipperEnabled");
+
+    addSection("MEMORY");
+    addSlider("idleSuspendSeconds");
+}
+
+EnginePanel::~EnginePanel()
+{
+    // Attachments detach from their parameters before the controls go
+    sliderAttachments.clear();
+    buttonAttachments.clear();
+    choiceAttachments.clear();
+}
+
+//==============================================================================
+void EnginePanel::paint (juce::Graphics& g)
+{
+    g.fillAll(black);
+    g.setColour(white);
+    g.drawRect(getLocalBounds(), 2);
+}
+
+void EnginePanel::resized()
+{
+    // Sections flow down each column; a section never starts in the last row of one
+    int x = margin;
+    int y = margin;
+
+    for (auto& row : rows)
+    {
+        const bool full = y + rowHeight > getHeight() - margin;
+        const bool orphanedTitle = row.isSection && y + 2 * rowHeight > getHeight() - margin;
+        if (full || orphanedTitle)
+        {
+            x += columnWidth + margin;
+            y = margin;
+        }
+
+        if (row.isSection && y != margin)
+            y += rowHeight / 2;
+
+        if (row.control != nullptr)
+        {
+            row.label->setBounds(x, y, columnWidth / 2, rowHeight);
+            row.control->setBounds(x + columnWidth / 2, y + 2, columnWidth / 2, rowHeight - 4);
+        }
+        else
+        {
+            row.label->setBounds(x, y, columnWidth, rowHeight);
+        }
+
+        y += rowHeight;
+    }
+}
+
+//==============================================================================
+EnginePanel::Row& EnginePanel::addRow(const juce::String& text)
+{
+    Row row;
+    row.label = std::make_unique<juce::Label>(text, text);
+    row.label->setColour(juce::Label::textColourId, white);
+    addAndMakeVisible(row.label.get());
+
+    rows.push_back(std::move(row));
+    return rows.back();
+}
+
+juce::RangedAudioParameter& EnginePanel::getParameter(const juce::String& parameterID)
+{
+    auto* parameter = audioProcessor.getHostParameters().find(parameterID);
+    jassert (parameter != nullptr);
+    return *parameter;
+}
+
+void EnginePanel::addSection(const juce::String& title)
+{
+    auto& row = addRow(title);
+    row.isSection = true;
+    row.label->setFont(Font(Font::getDefaultSansSerifFontName(), 13.0f, Font::bold));
+}
+
+void EnginePanel::addSlider(const juce::String& parameterID)
+{
+    auto& parameter = getParameter(parameterID);
+    auto& row = addRow(parameter.getName(32));
+
+    auto slider = std::make_unique<juce::Slider>();
+    slider->setSliderStyle(Slider::SliderStyle::LinearHorizontal);
+    slider->setTextBoxStyle(Slider::TextBoxRight, false, 44, rowHeight - 4);
+    sliderAttachments.push_back(std::make_unique<juce::SliderParameterAttachment>(parameter, *slider));
+
+    addAndMakeVisible(slider.get());
+    row.control = std::move(slider);
+}
+
+void EnginePanel::addToggle(const juce::String& parameterID)
+{
+    auto& parameter = getParameter(parameterID);
+    auto& row = addRow(parameter.getName(32));
+
+    auto toggle = std::make_unique<juce::ToggleButton>();
+    buttonAttachments.push_back(std::make_unique<juce::ButtonParameterAttachment>(parameter, *toggle));
+
+    addAndMakeVisible(toggle.get());
+    row.control = std::move(toggle);
+}
+
+void EnginePanel::addChoice(const juce::String& parameterID)
+{
+    auto& parameter = getParameter(parameterID);
+    auto& row = addRow(parameter.getName(32));
+
+    // The attachment selects by item index, so the items mirror the parameter's choices
+    auto choice = std::make_unique<juce::ComboBox>();
+    choice->addItemList(parameter.getAllValueStrings(), 1);
+    choiceAttachments.push_back(std::make_unique<juce::ComboBoxParameterAttachment>(parameter, *choice));
+
+    addAndMakeVisible(choice.get());
+    row.control = std::move(choice);
+}
+
+void EnginePanel::addAction(const juce::String& name, std::function<void()> action)
+{
+    auto& row = addRow({});
+
+    auto button = std::make_unique<juce::TextButton>(name);
+    button->onClick = std::move(action);
+
+    addAndMakeVisible(button.get());
+    row.control = std::move(button);
+}
+
+void EnginePanel::addPicker(const juce::String& name, const juce::StringArray& items, int& selectedIndex)
+{
+    auto& row = addRow(name);
+
+    auto picker = std::make_unique<juce::ComboBox>();
+    picker->addItemList(items, 1);
+    picker->setSelectedItemIndex(selectedIndex, juce::dontSendNotification);
+
+    auto* pickerPointer = picker.get();
+    picker->onChange = [pickerPointer, &selectedIndex] { selectedIndex = pickerPointer->getSelectedItemIndex(); };
+
+    addAndMakeVisible(picker.get());
+    row.control = std::move(picker);
+}
+
+void EnginePanel::addValue(const juce::String& name, int minimum, int maximum, int& value)
+{
+    auto& row = addRow(name);
+
+    auto slider = std::make_unique<juce::Slider>();
+    slider->setSliderStyle(Slider::SliderStyle::LinearHorizontal);
+    slider->setTextBoxStyle(Slider::TextBoxRight, false, 44, rowHeight - 4);
+    slider->setRange(minimum, maximum, 1.0);
+    slider->setValue(value, juce::dontSendNotification);
+
+    auto* sliderPointer = slider.get();
+    slider->onValueChange = [sliderPointer, &value] { value = juce::roundToInt(sliderPointer->getValue()); };
+
+    addAndMakeVisible(slider.get());
+    row.control = std::move(slider);
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    EnginePanel.h
+
+    Overlay with the synthesis engine's host parameters and actions.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Engine Panel - Parameter Controls Over the Canvas
+ *
+ * Covers the canvas when the ENGINE button in the bottom strip is on. Every
+ * control is attached to one of the processor's host parameters, so the
+ * panel, host automation and saved state always agree. Sections flow down
+ * fixed-width columns in the order they are added.
+ */
+class EnginePanel  : public juce::Component
+{
+public:
+    EnginePanel(DUMUMUB003AudioProcessor& p);
+    ~EnginePanel() override;
+
+    // Called after an action replaced the editor patch, so the editor can refresh its controls
+    std::function<void()> onPatchChanged;
+
+    void paint (juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    // Construction helpers, one row each
+    void addSection(const juce::String& title);
+    void addSlider(const juce::String& parameterID);
+    void addToggle(const juce::String& parameterID);
+    void addChoice(const juce::String& parameterID);
+    void addAction(const juce::String& name, std::function<void()> action);
+    void addPicker(const juce::String& name, const juce::StringArray& items, int& selectedIndex);
+    void addValue(const juce::String& name, int minimum, int maximum, int& value);
+
+    struct Row
+    {
+        std::unique_ptr<juce::Label> label;
+        std::unique_ptr<juce::Component> control;
+        bool isSection = false;
+    };
+
+    Row& addRow(const juce::String& text);
+    juce::RangedAudioParameter& getParameter(const juce::String& parameterID);
+
+    DUMUMUB003AudioProcessor& audioProcessor;
+
+    std::vector<Row> rows;
+    std::vector<std::unique_ptr<juce::SliderParameterAttachment>> sliderAttachments;
+    std::vector<std::unique_ptr<juce::ButtonParameterAttachment>> buttonAttachments;
+    std::vector<std::unique_ptr<juce::ComboBoxParameterAttachment>> choiceAttachments;
+
+    // Editor-only selections used by the actions
+    int selectedPart = 0;       // Index into parts 1-15
+    int selectedZoneSet = 0;
+    int selectedZone = 0;
+    WavetableZone zoneRange;
+
+    // Layout
+    static constexpr int columnWidth = 192;     // Five columns fit across the canvas
+    static constexpr int rowHeight = 24;
+    static constexpr int margin = 8;
+
+    // Colour Scheme (matches the editor)
+    Colour black = Colour::fromRGBA(20, 20, 0, 255);
+    Colour white = Colour::fromRGBA(255, 255, 242, 255);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EnginePanel)
+};
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    GranularOscillator.h
+
+    Granular playback engine for DUMUMUB wavetable synthesizer.
+    Plays windowed grains from anywhere in the dropped audio buffer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// User-facing granular controls, shared by every voice
+struct GranularParameters
+{
+    float position = 0.5f;  // Grain centre within the source buffer (0 - 1)
+    float size = 80.0f;     // Grain length in milliseconds
+    float density = 20.0f;  // Grains started per second
+    float spray = 0.1f;     // Random position offset as a fraction of the buffer (0 - 1)
+    float pitch = 0.0f;     // Grain transposition in semitones
+};
+
+//==============================================================================
+/**
+ * Precomputed Hann window shared by all grains.
+ * Built once and read with linear interpolation so grains of any length
+ * never evaluate a cosine on the audio thread.
+ */
+struct GrainWindow
+{
+    static constexpr int size = 1024;
+
+    static const std::array<float, size + 1>& get()
+    {
+        static const std::array<float, size + 1> table = []
+        {
+            std::array<float, size + 1> t;
+            for (int i = 0; i <= size; ++i)
+                t[i] = 0.5f - 0.5f * std::cos (2.0f * juce::MathConstants<float>::pi * (float) i / (float) size);
+            return t;
+        }();
+
+        return table;
+    }
+};
+
+//==============================================================================
+/**
+ * Granular Oscillator - Per-Voice Grain Cloud
+ *
+ * Schedules grains at the requested density and renders them from a fixed,
+ * pre-allocated grain pool. Each grain is gathered into a scratch block and
+ * then summed into the output with vectorised adds, so overlapping grains
+ * cost one SIMD accumulate each rather than scattered per-sample writes.
+ */
+class GranularOscillator
+{
+public:
+    static constexpr int maxGrains = 64;
+    static constexpr int maxBlockSize = 256;
+
+    GranularOscillator()
+    {
+        reset();
+    }
+
+    // Kill all grains and return every slot to the free list
+    void reset()
+    {
+        for (int i = 0; i < maxGrains; ++i)
+        {
+            grains[i].active = false;
+            freeList[i] = maxGrains - 1 - i;
+        }
+        numFree = maxGrains;
+        samplesUntilNextGrain = 0.0;
+    }
+
+    // Set the transposition of the played note relative to the source's root (middle C)
+    void setNoteRatio(double newRatio) { noteRatio = newRatio; }
+
+    int getNumActiveGrains() const { return maxGrains - numFree; }
+
+    /**
+     * Render granular output into the left/right scratch blocks (overwriting them).
+     * numSamples must not exceed maxBlockSize.
+     */
+    void render(const juce::AudioBuffer<float>& source, double sourceSampleRate, double outputSampleRate,
+                const GranularParameters& params, float* left, float* right, int numSamples)
+    {
+        jassert (numSamples <= maxBlockSize);
+
+        juce::FloatVectorOperations::clear(left, numSamples);
+        juce::FloatVectorOperations::clear(right, numSamples);
+
+        const int sourceLength = source.getNumSamples();
+        if (sourceLength < 2 || source.getNumChannels() == 0 || outputSampleRate <= 0.0)
+            return;
+
+        // Start any grains that fall inside this block
+        const double grainInterval = outputSampleRate / juce::jlimit(0.1f, 1000.0f, params.density);
+        const double grainLength = juce::jmax(1.0, params.size * 0.001 * outputSampleRate);
+
+        while (samplesUntilNextGrain < numSamples)
+        {
+            startGrain(juce::jmax(0, (int) samplesUntilNextGrain), sourceLength, sourceSampleRate,
+                       outputSampleRate, grainLength, params);
+            samplesUntilNextGrain += grainInterval;
+        }
+        samplesUntilNextGrain -= numSamples;
+
+        // Normalise so the cloud level stays steady as grains overlap
+        const float overlap = (float) (grainLength / grainInterval);
+        const float cloudGain = 1.0f / std::sqrt(juce::jmax(1.0f, overlap));
+
+        const float* sourceL = source.getReadPointer(0);
+        const float* sourceR = source.getReadPointer(juce::jmin(1, source.getNumChannels() - 1));
+        const auto& window = GrainWindow::get();
+
+        for (int g = 0; g < maxGrains; ++g)
+        {
+            auto& grain = grains[g];
+            if (!grain.active)
+                continue;
+
+            const int start = grain.startOffset;
+            int count = numSamples - start;
+            grain.startOffset = 0;
+
+            // Gather windowed source samples for this grain into scratch
+            int rendered = 0;
+            for (; rendered < count; ++rendered)
+            {
+                if (grain.windowPhase >= (float) GrainWindow::size)
+                    break;
+
+                int index = (int) grain.sourcePosition;
+                if (index < 0 || index >= sourceLength - 1)
+                    break;
+
+                const float frac = (float) (grain.sourcePosition - index);
+                const int windowIndex = (int) grain.windowPhase;
+                const float windowFrac = grain.windowPhase - (float) windowIndex;
+                const float w = window[windowIndex] + windowFrac * (window[windowIndex + 1] - window[windowIndex]);
+
+                grainScratchL[rendered] = (sourceL[index] + frac * (sourceL[index + 1] - sourceL[index])) * w;
+                grainScratchR[rendered] = (sourceR[index] + frac * (sourceR[index + 1] - sourceR[index])) * w;
+
+                grain.sourcePosition += grain.increment;
+                grain.windowPhase += grain.windowIncrement;
+            }
+
+            // Sum the grain into the cloud with vectorised accumulates
+            juce::FloatVectorOperations::addWithMultiply(left + start, grainScratchL.data(), cloudGain, rendered);
+            juce::FloatVectorOperations::addWithMultiply(right + start, grainScratchR.data(), cloudGain, rendered);
+
+            if (rendered < count)
+                releaseGrain(g);
+        }
+    }
+
+private:
+    struct Grain
+    {
+        bool active = false;
+        int startOffset = 0;        // Sample offset within the current block where the grain begins
+        double sourcePosition = 0.0;
+        double increment = 1.0;
+        float windowPhase = 0.0f;
+        float windowIncrement = 0.0f;
+    };
+
+    void startGrain(int offset, int sourceLength, double sourceSampleRate, double outputSampleRate,
+                    double grainLength, const GranularParameters& params)
+    {
+        if (numFree == 0)
+            return; // Pool exhausted - drop the grain rather than allocate
+
+        const int slot = freeList[--numFree];
+        auto& grain = grains[slot];
+
+        // Transposition combines the played note, the pitch control and the file's sample rate
+        grain.increment = noteRatio * std::exp2(params.pitch / 12.0) * (sourceSampleRate / outputSampleRate);
+
+        // Centre the grain on the position control, offset by random spray
+        const double sprayOffset = (random.nextFloat() * 2.0f - 1.0f) * params.spray * sourceLength;
+        const double span = grainLength * grain.increment;
+        double centre = params.position * (sourceLength - 1) + sprayOffset;
+        grain.sourcePosition = juce::jlimit(0.0, juce::jmax(0.0, sourceLength - 1 - span), centre - span * 0.5);
+
+        grain.windowPhase = 0.0f;
+        grain.windowIncrement = (float) (GrainWindow::size / grainLength);
+        grain.startOffset = offset;
+        grain.active = true;
+    }
+
+    void releaseGrain(int slot)
+    {
+        grains[slot].active = false;
+        freeList[numFree++] = slot;
+    }
+
+    // Fixed grain pool with free-slot stack
+    std::array<Grain, maxGrains> grains;
+    std::array<int, maxGrains> freeList;
+    int numFree = 0;
+
+    // Grain scheduling
+    double samplesUntilNextGrain = 0.0;
+    double noteRatio = 1.0;
+    juce::Random random;
+
+    // Per-grain gather scratch
+    std::array<float, maxBlockSize> grainScratchL;
+    std::array<float, maxBlockSize> grainScratchR;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GranularOscillator)
+};
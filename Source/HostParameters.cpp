@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    HostParameters.cpp
+
+    Parameter registration, change forwarding and state synchronisation.
+
+  ==============================================================================
+*/
+
+#include "HostParameters.h"
+
+//==============================================================================
+HostParameters::HostParameters(juce::AudioProcessor& owner) : processor(owner)
+{
+}
+
+HostParameters::~HostParameters()
+{
+    for (auto& binding : bindings)
+        binding->parameter->removeListener(this);
+}
+
+void HostParameters::add(std::unique_ptr<juce::RangedAudioParameter> parameter,
+                         std::function<void(float)> apply, std::function<float()> read, Thread thread)
+{
+    auto binding = std::make_unique<Binding>();
+    binding->parameter = parameter.get();
+    binding->apply = std::move(apply);
+    binding->read = std::move(read);
+    binding->thread = thread;
+
+    // Start from the engine's current setting, then hand ownership to the processor
+    binding->parameter->setValueNotifyingHost(binding->parameter->convertTo0to1(binding->read()));
+    binding->parameter->addListener(this);
+    processor.addParameter(parameter.release());
+
+    // Every processor parameter is registered here, so binding and parameter indices match
+    jassert (binding->parameter->getParameterIndex() == static_cast<int>(bindings.size()));
+    bindings.push_back(std::move(binding));
+}
+
+void HostParameters::applyPending()
+{
+    for (auto& binding : bindings)
+        if (binding->pending.exchange(false))
+            applyNow(*binding);
+}
+
+void HostParameters::pullFromEngine()
+{
+    // The setters already hold the restored values, so the echo of each change is skipped
+    pulling = true;
+    for (auto& binding : bindings)
+    {
+        const float normalised = binding->parameter->convertTo0to1(binding->read());
+        if (normalised != binding->parameter->getValue())
+            binding->parameter->setValueNotifyingHost(normalised);
+    }
+    pulling = false;
+}
+
+juce::RangedAudioParameter* HostParameters::find(const juce::String& parameterID) const
+{
+    for (auto& binding : bindings)
+        if (binding->parameter->getParameterID() == parameterID)
+            return binding->parameter;
+
+    jassertfalse;
+    return nullptr;
+}
+
+//==============================================================================
+void HostParameters::parameterValueChanged(int parameterIndex, float)
+{
+    if (parameterIndex < 0 || parameterIndex >= static_cast<int>(bindings.size()))
+        return;
+
+    auto& binding = *bindings[static_cast<size_t>(parameterIndex)];
+    if (pulling)
+        return;
+
+    if (binding.thread == Thread::any || juce::MessageManager::existsAndIsCurrentThread())
+        applyNow(binding);
+    else
+        binding.pending = true;
+}
+
+void HostParameters::applyNow(Binding& binding)
+{
+    const auto* parameter = binding.parameter;
+    binding.apply(parameter->convertFrom0to1(parameter->getValue()));
+}
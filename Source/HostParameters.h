@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    HostParameters.h
+
+    Host-automatable parameters bound to the DUMUMUB engine settings.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * Host Parameters - AudioProcessorParameter Bindings for Engine Settings
+ *
+ * The engine keeps its settings behind the processor's setters (and saves
+ * them in its own XML state). Each parameter registered here is bound to
+ * one setter and one getter: a change from the host or an editor
+ * attachment calls the setter, and after a state restore the parameters
+ * are moved to whatever the setters now report.
+ *
+ * Setters that only store atomics are applied on whichever thread changed
+ * the parameter. Setters that rebuild, post work or change latency are
+ * marked as message-thread only; changes arriving on other threads (host
+ * automation on the audio thread) are flagged and applied from the
+ * processor's timer.
+ */
+class HostParameters : private juce::AudioProcessorParameter::Listener
+{
+public:
+    explicit HostParameters(juce::AudioProcessor& owner);
+    ~HostParameters() override;
+
+    enum class Thread { any, message };
+
+    // Processor constructor only: register a parameter bound to a setter and getter (plain values)
+    void add(std::unique_ptr<juce::RangedAudioParameter> parameter,
+             std::function<void(float)> apply, std::function<float()> read, Thread thread = Thread::any);
+
+    // Message thread: apply changes that arrived on other threads
+    void applyPending();
+
+    // Message thread, after the setters restored state: move every parameter to its setting
+    void pullFromEngine();
+
+    juce::RangedAudioParameter* find(const juce::String& parameterID) const;
+
+private:
+    struct Binding
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        std::function<void(float)> apply;
+        std::function<float()> read;
+        Thread thread = Thread::any;
+        std::atomic<bool> pending { false };
+    };
+
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+
+    void applyNow(Binding& binding);
+
+    juce::AudioProcessor& processor;
+    std::vector<std::unique_ptr<Binding>> bindings;
+    bool pulling = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HostParameters)
+};
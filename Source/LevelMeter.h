@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+
+    Output level metering for DUMUMUB wavetable synthesizer.
+    Block RMS and peak on the audio thread, ballistics on the GUI thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/**
+ * Level Meter - Audio-Thread RMS and Peak Measurement
+ *
+ * Measures each channel of a block in one pass: peak from the vectorised
+ * min/max search, RMS from a sum of squares split over four accumulators so
+ * the compiler can keep it in one SIMD register. Results are published
+ * through atomics. Peaks accumulate until the GUI takes them, so short
+ * transients between two repaints are never lost.
+ */
+class LevelMeter
+{
+public:
+    static constexpr int numChannels = 2;
+
+    LevelMeter() = default;
+
+    // Audio thread: measure a block (extra channels are ignored, missing ones read as silence)
+    void process(const juce::AudioBuffer<float>& buffer)
+    {
+        const int numSamples = buffer.getNumSamples();
+        if (numSamples == 0)
+            return;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            float rmsValue = 0.0f;
+            float peakValue = 0.0f;
+
+            if (channel < buffer.getNumChannels())
+            {
+                const float* samples = buffer.getReadPointer(channel);
+
+                float minimum = 0.0f, maximum = 0.0f;
+                juce::FloatVectorOperations::findMinAndMax(samples, numSamples, minimum, maximum);
+                peakValue = juce::jmax(maximum, -minimum);
+                rmsValue = std::sqrt(sumOfSquares(samples, numSamples) / numSamples);
+            }
+
+            rms[static_cast<size_t>(channel)].store(rmsValue, std::memory_order_relaxed);
+
+            // Keep the largest peak since the GUI last took one
+            auto& held = peak[static_cast<size_t>(channel)];
+            float current = held.load(std::memory_order_relaxed);
+            while (peakValue > current && !held.compare_exchange_weak(current, peakValue, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    // GUI thread: RMS of the most recent block
+    float getRMS(int channel) const
+    {
+        return rms[static_cast<size_t>(channel)].load(std::memory_order_relaxed);
+    }
+
+    // GUI thread: largest peak since the previous call
+    float takePeak(int channel)
+    {
+        return peak[static_cast<size_t>(channel)].exchange(0.0f, std::memory_order_relaxed);
+    }
+
+    //==============================================================================
+    /**
+     * Meter ballistics for one channel, run on the GUI timer. The level rises
+     * with a short attack and falls with a slower release; the peak hold sits
+     * on the highest peak for holdSeconds and then falls at decayPerSecond.
+     */
+    struct Ballistics
+    {
+        float attackSeconds = 0.01f;
+        float releaseSeconds = 0.3f;
+        float holdSeconds = 1.5f;
+        float decayPerSecond = 0.5f;
+
+        float level = 0.0f;
+        float peakHold = 0.0f;
+        float holdRemaining = 0.0f;
+
+        void update(float newRMS, float newPeak, float elapsedSeconds)
+        {
+            const float time = newRMS > level ? attackSeconds : releaseSeconds;
+            level += (newRMS - level) * (1.0f - std::exp(-elapsedSeconds / time));
+
+            if (newPeak >= peakHold)
+            {
+                peakHold = newPeak;
+                holdRemaining = holdSeconds;
+            }
+            else if (holdRemaining > 0.0f)
+            {
+                holdRemaining -= elapsedSeconds;
+            }
+            else
+            {
+                peakHold = juce::jmax(newPeak, peakHold - decayPerSecond * elapsedSeconds);
+            }
+        }
+    };
+
+    // Sum of squares over four accumulators (also used by the loudness meter)
+    static float sumOfSquares(const float* samples, int numSamples)
+    {
+        std::array<float, 4> sums { 0.0f, 0.0f, 0.0f, 0.0f };
+        const int wholeSteps = numSamples / 4;
+
+        for (int step = 0; step < wholeSteps; ++step)
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                const float sample = samples[step * 4 + lane];
+                sums[static_cast<size_t>(lane)] += sample * sample;
+            }
+
+        float sum = sums[0] + sums[1] + sums[2] + sums[3];
+        for (int i = wholeSteps * 4; i < numSamples; ++i)
+            sum += samples[i] * samples[i];
+
+        return sum;
+    }
+
+private:
+    std::array<std::atomic<float>, numChannels> rms {};
+    std::array<std::atomic<float>, numChannels> peak {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LevelMeter)
+};
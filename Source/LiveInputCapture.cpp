@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    LiveInputCapture.cpp
+
+    Sidechain FIFO, analysis thread and table hand-over for live capture.
+
+  ==============================================================================
+*/
+
+#include "LiveInputCapture.h"
+
+namespace
+{
+    // History is sized once for the highest supported rate so analysis never reallocates
+    constexpr double highestSampleRate = 192000.0;
+}
+
+//==============================================================================
+LiveInputCapture::LiveInputCapture() : juce::Thread("DUMUMUB Live Capture")
+{
+    const size_t historyLength = static_cast<size_t>(CycleExtractor::getRequiredLength(highestSampleRate));
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        fifoData[channel].assign(fifoSize, 0.0f);
+        history[channel].assign(historyLength, 0.0f);
+    }
+    mono.assign(historyLength, 0.0f);
+
+    capturedL.fill(0.0f);
+    capturedR.fill(0.0f);
+    readyL.fill(0.0f);
+    readyR.fill(0.0f);
+}
+
+LiveInputCapture::~LiveInputCapture()
+{
+    stopThread(2000);
+}
+
+void LiveInputCapture::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+
+    if (shouldBeEnabled)
+        startThread(juce::Thread::Priority::low);
+    else
+        stopThread(2000);
+}
+
+void LiveInputCapture::prepare(double newSampleRate)
+{
+    sampleRate = juce::jmin(newSampleRate, highestSampleRate);
+}
+
+//==============================================================================
+void LiveInputCapture::push(const juce::AudioBuffer<float>& sidechain)
+{
+    if (!enabled || sidechain.getNumChannels() == 0)
+        return;
+
+    // Drop input rather than block if analysis has fallen behind
+    const int numSamples = juce::jmin(sidechain.getNumSamples(), fifo.getFreeSpace());
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const float* source = sidechain.getReadPointer(juce::jmin(channel, sidechain.getNumChannels() - 1));
+        juce::FloatVectorOperations::copy(fifoData[channel].data() + start1, source, size1);
+        if (size2 > 0)
+            juce::FloatVectorOperations::copy(fifoData[channel].data() + start2, source + size1, size2);
+    }
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+bool LiveInputCapture::collect(std::array<float, 1024>& tableL, std::array<float, 1024>& tableR)
+{
+    if (slotState.load(std::memory_order_acquire) != 1)
+        return false;
+
+    tableL = readyL;
+    tableR = readyR;
+    slotState.store(0, std::memory_order_release);
+    return true;
+}
+
+//==============================================================================
+void LiveInputCapture::run()
+{
+    while (!threadShouldExit())
+    {
+        // Drain a hop at a time, so each pass shifts the history once and ends in an analysis
+        const int available = fifo.getNumReady();
+        if (available < analysisHop)
+        {
+            wait(10);
+            continue;
+        }
+
+        // Slide the newest input onto the end of the analysis history
+        const int historyLength = static_cast<int>(history[0].size());
+        const int numSamples = juce::jmin(available, historyLength);
+
+        int start1, size1, start2, size2;
+        fifo.prepareToRead(numSamples, start1, size1, start2, size2);
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto& channelHistory = history[channel];
+            std::copy(channelHistory.begin() + numSamples, channelHistory.end(), channelHistory.begin());
+
+            float* destination = channelHistory.data() + historyLength - numSamples;
+            std::copy(fifoData[channel].data() + start1, fifoData[channel].data() + start1 + size1, destination);
+            std::copy(fifoData[channel].data() + start2, fifoData[channel].data() + start2 + size2, destination + size1);
+        }
+
+        fifo.finishedRead(size1 + size2);
+        analyse();
+    }
+}
+
+void LiveInputCapture::analyse()
+{
+    const double rate = sampleRate;
+    const int length = CycleExtractor::getRequiredLength(rate);
+    const int offset = static_cast<int>(history[0].size()) - length;
+
+    const float* left = history[0].data() + offset;
+    const float* right = history[1].data() + offset;
+
+    for (int i = 0; i < length; ++i)
+        mono[static_cast<size_t>(i)] = 0.5f * (left[i] + right[i]);
+
+    const float period = extractor.detectPeriod(mono.data(), length, rate);
+    if (period <= 0.0f || !extractor.extractCycle(left, right, length, period, capturedL, capturedR))
+        return;
+
+    // Hand over only if the previous table has been collected
+    if (slotState.load(std::memory_order_acquire) != 0)
+        return;
+
+    readyL = capturedL;
+    readyR = capturedR;
+    slotState.store(1, std::memory_order_release);
+}
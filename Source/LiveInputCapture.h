@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    LiveInputCapture.h
+
+    Live wavetable capture from the sidechain input of DUMUMUB wavetable synthesizer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CycleExtractor.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Live Input Capture - Sidechain to Wavetable Resynthesis
+ *
+ * The audio thread only pushes sidechain samples into a lock-free FIFO.
+ * An analysis thread drains the FIFO, tracks pitch, extracts the most recent
+ * cycle and hands it over through a single-slot mailbox that the processor's
+ * timer collects from, so the editor tables are only written on the message
+ * thread. The analysis thread only writes the slot while it is free, and a
+ * frame is dropped if the previous one has not been collected yet.
+ */
+class LiveInputCapture : private juce::Thread
+{
+public:
+    LiveInputCapture();
+    ~LiveInputCapture() override;
+
+    // Message thread: start or stop analysis
+    void setEnabled(bool shouldBeEnabled);
+    bool isEnabled() const { return enabled; }
+
+    void prepare(double sampleRate);
+
+    // Audio thread: queue sidechain audio (mono inputs feed both sides)
+    void push(const juce::AudioBuffer<float>& sidechain);
+
+    // Message thread: copy a newly captured cycle into the tables, if one is ready
+    bool collect(std::array<float, 1024>& tableL, std::array<float, 1024>& tableR);
+
+private:
+    static constexpr int fifoSize = 1 << 15;
+    static constexpr int analysisHop = 1024;
+
+    void run() override;
+    void analyse();
+
+    // Audio thread -> analysis thread
+    juce::AbstractFifo fifo { fifoSize };
+    std::array<std::vector<float>, 2> fifoData;
+
+    // Analysis thread only
+    CycleExtractor extractor;
+    std::array<std::vector<float>, 2> history;
+    std::vector<float> mono;
+    std::array<float, 1024> capturedL;
+    std::array<float, 1024> capturedR;
+
+    // Analysis thread -> message thread (0 = slot free, 1 = table ready)
+    std::array<float, 1024> readyL;
+    std::array<float, 1024> readyR;
+    std::atomic<int> slotState { 0 };
+
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<bool> enabled { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LiveInputCapture)
+};
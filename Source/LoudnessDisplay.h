@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    LoudnessDisplay.h
+
+    One-line EBU R128 loudness and true-peak readout for the editor's status strip.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+ * Loudness Display - LUFS, LRA and dBTP Readout
+ *
+ * Shows the processor's loudness meter in the status strip under the
+ * artwork, refreshed ten times a second: momentary, short-term and
+ * integrated loudness, loudness range and true peak. Values the meter has
+ * not measured yet read as dashes. Double-click starts a new measurement.
+ */
+class LoudnessDisplay  : public juce::Component, public juce::TooltipClient, private juce::Timer
+{
+public:
+    LoudnessDisplay(DUMUMUB003AudioProcessor& p) : audioProcessor(p)
+    {
+        startTimerHz(10);
+    }
+
+    ~LoudnessDisplay() override
+    {
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        g.setColour(Colour::fromRGBA(255, 255, 242, 255));
+        Font font(Font::getDefaultSansSerifFontName(), 12.0f, Font::plain);
+        font.setExtraKerningFactor(0.3f);
+        g.setFont(font);
+        g.drawText(text, 0, 0, getWidth(), getHeight(), Justification::centredLeft);
+    }
+
+    juce::String getTooltip() override
+    {
+        return "Loudness (EBU R128) and true peak since the last reset. Double-click to reset.";
+    }
+
+    void mouseDoubleClick (const juce::MouseEvent&) override
+    {
+        audioProcessor.getLoudnessMeter().requestReset();
+    }
+
+private:
+    static String format(float value, float silence)
+    {
+        return value <= silence ? String("--.-") : String(value, 1);
+    }
+
+    void timerCallback() override
+    {
+        const auto& meter = audioProcessor.getLoudnessMeter();
+        const float silence = LoudnessMeter::silence;
+
+        String newText;
+        newText << "M " << format(meter.getMomentary(), silence)
+                << "   S " << format(meter.getShortTerm(), silence)
+                << "   I " << format(meter.getIntegrated(), silence) << " LUFS"
+                << "   LRA " << String(meter.getRange(), 1) << " LU"
+                << "   TP " << format(meter.getTruePeak(), silence) << " DBTP";
+
+        if (newText != text)
+        {
+            text = newText;
+            repaint();
+        }
+    }
+
+    DUMUMUB003AudioProcessor& audioProcessor;
+    String text;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessDisplay)
+};
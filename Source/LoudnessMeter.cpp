@@ -0,0 +1,279 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.cpp
+
+    K-weighting, 100 ms energy steps and histogram gating.
+
+  ==============================================================================
+*/
+
+#include "LoudnessMeter.h"
+#include "LevelMeter.h"
+
+//==============================================================================
+LoudnessMeter::LoudnessMeter()
+{
+    // Centre energy of each gating bin, so gated means need no pow() on the audio thread
+    for (int bin = 0; bin < histogramBins; ++bin)
+    {
+        const double loudness = histogramFloor + (bin + 0.5) * histogramStep;
+        binEnergies[static_cast<size_t>(bin)] = std::pow(10.0, (loudness + 0.691) / 10.0);
+    }
+}
+
+void LoudnessMeter::prepare(double sampleRate, int maximumBlockSize)
+{
+    // BS.1770 pre-filter (high shelf) and RLB high-pass, derived for this rate
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        shelf.b0 = static_cast<float>((vh + vb * k / q + k * k) / a0);
+        shelf.b1 = static_cast<float>(2.0 * (k * k - vh) / a0);
+        shelf.b2 = static_cast<float>((vh - vb * k / q + k * k) / a0);
+        shelf.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        shelf.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        highPass.b0 = 1.0f;
+        highPass.b1 = -2.0f;
+        highPass.b2 = 1.0f;
+        highPass.a1 = static_cast<float>(2.0 * (k * k - 1.0) / a0);
+        highPass.a2 = static_cast<float>((1.0 - k / q + k * k) / a0);
+    }
+
+    stepLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    const int blockSize = juce::jmax(32, maximumBlockSize);
+    weighted.assign(static_cast<size_t>(blockSize * numChannels), 0.0f);
+    peaks.assign(static_cast<size_t>(blockSize), 0.0f);
+    for (auto& detector : detectors)
+        detector.prepare(blockSize);
+
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    for (auto& state : filterState)
+        state.fill(0.0f);
+    for (auto& detector : detectors)
+        detector.reset();
+
+    stepPosition = 0;
+    stepEnergy = 0.0;
+    stepEnergies.fill(0.0);
+    stepIndex = 0;
+    stepsMeasured = 0;
+    maximumPeak = 0.0f;
+    blockHistogram.clear();
+    shortTermHistogram.clear();
+
+    momentary = silence;
+    shortTerm = silence;
+    integrated = silence;
+    range = 0.0f;
+    truePeak = silence;
+}
+
+//==============================================================================
+void LoudnessMeter::process(const juce::AudioBuffer<float>& buffer)
+{
+    if (!enabled || weighted.empty())
+        return;
+
+    if (resetRequested.exchange(false))
+        reset();
+
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    const int blockSize = static_cast<int>(peaks.size());
+
+    for (int start = 0; start < buffer.getNumSamples(); start += blockSize)
+    {
+        const int count = juce::jmin(blockSize, buffer.getNumSamples() - start);
+
+        // True peak over all channels
+        juce::FloatVectorOperations::clear(peaks.data(), count);
+        for (int channel = 0; channel < channels; ++channel)
+            detectors[static_cast<size_t>(channel)].accumulate(buffer.getReadPointer(channel, start), count, peaks.data());
+        maximumPeak = juce::jmax(maximumPeak, juce::FloatVectorOperations::findMaximum(peaks.data(), count));
+
+        for (int channel = 0; channel < channels; ++channel)
+            kWeight(channel, buffer.getReadPointer(channel, start), weighted.data() + channel * blockSize, count);
+
+        // Channel energies (L and R both weighted 1.0) gathered into 100 ms steps
+        for (int position = 0; position < count;)
+        {
+            const int length = juce::jmin(count - position, stepLength - stepPosition);
+            for (int channel = 0; channel < channels; ++channel)
+                stepEnergy += LevelMeter::sumOfSquares(weighted.data() + channel * blockSize + position, length);
+
+            position += length;
+            stepPosition += length;
+            if (stepPosition == stepLength)
+                completeStep();
+        }
+    }
+
+    truePeak = maximumPeak > 0.0f ? juce::Decibels::gainToDecibels(maximumPeak, silence) : silence;
+}
+
+void LoudnessMeter::kWeight(int channel, const float* input, float* output, int numSamples)
+{
+    // Both stages in one pass with the state held in registers
+    auto& state = filterState[static_cast<size_t>(channel)];
+    float s1 = state[0], s2 = state[1], h1 = state[2], h2 = state[3];
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = input[i];
+        const float y = shelf.b0 * x + s1;
+        s1 = shelf.b1 * x - shelf.a1 * y + s2;
+        s2 = shelf.b2 * x - shelf.a2 * y;
+
+        const float z = highPass.b0 * y + h1;
+        h1 = highPass.b1 * y - highPass.a1 * z + h2;
+        h2 = highPass.b2 * y - highPass.a2 * z;
+
+        output[i] = z;
+    }
+
+    state = { s1, s2, h1, h2 };
+}
+
+void LoudnessMeter::completeStep()
+{
+    stepEnergies[static_cast<size_t>(stepIndex)] = stepEnergy / stepLength;
+    stepIndex = (stepIndex + 1) % shortTermSteps;
+    stepsMeasured = juce::jmin(stepsMeasured + 1, shortTermSteps);
+    stepEnergy = 0.0;
+    stepPosition = 0;
+
+    // Momentary: the 400 ms gating block ending here (blocks overlap by 75%)
+    if (stepsMeasured >= momentarySteps)
+    {
+        double blockEnergy = 0.0;
+        for (int i = 1; i <= momentarySteps; ++i)
+            blockEnergy += stepEnergies[static_cast<size_t>((stepIndex - i + shortTermSteps) % shortTermSteps)];
+        blockEnergy /= momentarySteps;
+
+        momentary = energyToLoudness(blockEnergy);
+        blockHistogram.add(blockEnergy);
+        updateIntegrated();
+    }
+
+    if (stepsMeasured >= shortTermSteps)
+    {
+        double windowEnergy = 0.0;
+        for (auto energy : stepEnergies)
+            windowEnergy += energy;
+        windowEnergy /= shortTermSteps;
+
+        shortTerm = energyToLoudness(windowEnergy);
+        shortTermHistogram.add(windowEnergy);
+        updateRange();
+    }
+}
+
+void LoudnessMeter::updateIntegrated()
+{
+    if (blockHistogram.total == 0)
+        return;
+
+    // Relative gate 10 LU under the mean of the blocks that passed the absolute gate
+    const float gate = energyToLoudness(blockHistogram.energy / static_cast<double>(blockHistogram.total)) - 10.0f;
+
+    double energy = 0.0;
+    juce::uint64 count = 0;
+    for (int bin = blockHistogram.firstBinAbove(gate); bin < histogramBins; ++bin)
+    {
+        const auto binCount = blockHistogram.counts[static_cast<size_t>(bin)];
+        energy += binCount * binEnergies[static_cast<size_t>(bin)];
+        count += binCount;
+    }
+
+    if (count > 0)
+        integrated = energyToLoudness(energy / static_cast<double>(count));
+}
+
+void LoudnessMeter::updateRange()
+{
+    if (shortTermHistogram.total == 0)
+        return;
+
+    // EBU Tech 3342: relative gate 20 LU down, then the 10th to 95th percentile spread
+    const float gate = energyToLoudness(shortTermHistogram.energy / static_cast<double>(shortTermHistogram.total)) - 20.0f;
+    const int first = shortTermHistogram.firstBinAbove(gate);
+
+    juce::uint64 count = 0;
+    for (int bin = first; bin < histogramBins; ++bin)
+        count += shortTermHistogram.counts[static_cast<size_t>(bin)];
+
+    if (count == 0)
+        return;
+
+    const double lowRank = 0.10 * static_cast<double>(count);
+    const double highRank = 0.95 * static_cast<double>(count);
+    int low = first, high = first;
+    juce::uint64 cumulative = 0;
+
+    for (int bin = first; bin < histogramBins; ++bin)
+    {
+        const juce::uint64 previous = cumulative;
+        cumulative += shortTermHistogram.counts[static_cast<size_t>(bin)];
+        if (static_cast<double>(previous) <= lowRank && static_cast<double>(cumulative) > lowRank)
+            low = bin;
+        if (static_cast<double>(previous) <= highRank && static_cast<double>(cumulative) > highRank)
+        {
+            high = bin;
+            break;
+        }
+    }
+
+    range = (high - low) * histogramStep;
+}
+
+float LoudnessMeter::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return silence;
+
+    return juce::jmax(silence, static_cast<float>(-0.691 + 10.0 * std::log10(energy)));
+}
+
+//==============================================================================
+void LoudnessMeter::Histogram::clear()
+{
+    counts.fill(0);
+    energy = 0.0;
+    total = 0;
+}
+
+void LoudnessMeter::Histogram::add(double blockEnergy)
+{
+    // Absolute gate at -70 LUFS
+    const float loudness = energyToLoudness(blockEnergy);
+    if (loudness < histogramFloor)
+        return;
+
+    const int bin = juce::jmin(histogramBins - 1, static_cast<int>((loudness - histogramFloor) / histogramStep));
+    ++counts[static_cast<size_t>(bin)];
+    energy += blockEnergy;
+    ++total;
+}
+
+int LoudnessMeter::Histogram::firstBinAbove(float loudness) const
+{
+    return juce::jlimit(0, histogramBins, static_cast<int>(std::ceil((loudness - histogramFloor) / histogramStep)));
+}
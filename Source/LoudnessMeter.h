@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    LoudnessMeter.h
+
+    EBU R128 loudness and true-peak metering for DUMUMUB wavetable synthesizer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TruePeakDetector.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+ * Loudness Meter - EBU R128 / ITU-R BS.1770 Loudness and True Peak
+ *
+ * Each block is K-weighted (high shelf then RLB high-pass, recomputed for
+ * the running sample rate) and its energy is gathered into 100 ms steps.
+ * Momentary loudness is the mean of the last 4 steps (400 ms), short-term
+ * the mean of the last 30 (3 s).
+ *
+ * Gating uses histograms with 0.1 LU bins from -70 to +5 LUFS. Each step
+ * adds one momentary block and one short-term value in O(1); the gated
+ * integrated loudness and the loudness range (10th to 95th percentile of
+ * short-term) are then read back with a scan of fixed length, so the cost
+ * never grows with programme length.
+ *
+ * True peak is the 4x oversampled maximum since the last reset, in dBTP.
+ * Results are published through atomics for the GUI.
+ */
+class LoudnessMeter
+{
+public:
+    static constexpr int numChannels = 2;
+    static constexpr float silence = -100.0f;
+
+    LoudnessMeter();
+
+    void prepare(double sampleRate, int maximumBlockSize);
+
+    // Audio thread: measure one output block
+    void process(const juce::AudioBuffer<float>& buffer);
+
+    // Any thread: start a new measurement at the next block
+    void requestReset() { resetRequested = true; }
+
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled; }
+
+    // LUFS, LU and dBTP (silence until there is enough programme to measure)
+    float getMomentary() const { return momentary; }
+    float getShortTerm() const { return shortTerm; }
+    float getIntegrated() const { return integrated; }
+    float getRange() const { return range; }
+    float getTruePeak() const { return truePeak; }
+
+private:
+    static constexpr int momentarySteps = 4;
+    static constexpr int shortTermSteps = 30;
+    static constexpr float histogramFloor = -70.0f;
+    static constexpr float histogramStep = 0.1f;
+    static constexpr int histogramBins = 750;
+
+    // Normalised biquad, transposed direct form II
+    struct Biquad
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    // Gating histogram with running totals of the blocks above the absolute gate
+    struct Histogram
+    {
+        std::array<juce::uint32, histogramBins> counts {};
+        double energy = 0.0;
+        juce::uint64 total = 0;
+
+        void clear();
+        void add(double blockEnergy);
+        int firstBinAbove(float loudness) const;
+    };
+
+    void reset();
+    void kWeight(int channel, const float* input, float* output, int numSamples);
+    void completeStep();
+    void updateIntegrated();
+    void updateRange();
+
+    static float energyToLoudness(double energy);
+
+    Biquad shelf, highPass;
+    std::array<std::array<float, 4>, numChannels> filterState {};
+    std::array<TruePeakDetector, numChannels> detectors;
+    std::vector<float> weighted;
+    std::vector<float> peaks;
+
+    int stepLength = 4800;
+    int stepPosition = 0;
+    double stepEnergy = 0.0;
+    std::array<double, shortTermSteps> stepEnergies {};
+    int stepIndex = 0;
+    int stepsMeasured = 0;
+    float maximumPeak = 0.0f;
+
+    std::array<double, histogramBins> binEnergies {};
+    Histogram blockHistogram;
+    Histogram shortTermHistogram;
+
+    std::atomic<bool> enabled { true };
+    std::atomic<bool> resetRequested { false };
+    std::atomic<float> momentary { silence };
+    std::atomic<float> shortTerm { silence };
+    std::atomic<float> integrated { silence };
+    std::atomic<float> range { 0.0f };
+    std::atomic<float> truePeak { silence };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessMeter)
+};
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    NoiseGenerator.h
+
+    Block-based noise source for the DUMUMUB voice noise layer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+/**
+ * Noise Generator - Four-Lane Xorshift Block Generator
+ *
+ * Four independent xorshift32 generators are stepped side by side and
+ * interleaved into the output, four samples per step. The lane loop has no
+ * cross-lane dependency, so the compiler maps it onto one SIMD register.
+ * Whole blocks are produced per call, with no per-sample juce::Random.
+ *
+ * Pink noise is white noise through Paul Kellet's three-pole economy filter.
+ */
+class NoiseGenerator
+{
+public:
+    enum class Colour
+    {
+        white = 0,
+        pink,
+        sampleAndHold
+    };
+
+    explicit NoiseGenerator(juce::uint32 seedValue = 0x9e3779b9u)
+    {
+        seed(seedValue);
+    }
+
+    // Spread one seed across the lanes (xorshift state must never be zero)
+    void seed(juce::uint32 seedValue)
+    {
+        for (auto& lane : lanes)
+        {
+            seedValue = seedValue * 1664525u + 1013904223u;
+            lane = seedValue != 0 ? seedValue : 0x6d2b79f5u;
+        }
+    }
+
+    // Uniform white noise in [-1, 1)
+    void generate(float* output, int numSamples)
+    {
+        const int wholeSteps = numSamples / numLanes;
+
+        for (int step = 0; step < wholeSteps; ++step)
+            nextStep(output + step * numLanes);
+
+        const int remaining = numSamples - wholeSteps * numLanes;
+        if (remaining > 0)
+        {
+            std::array<float, numLanes> tail;
+            nextStep(tail.data());
+            std::copy(tail.begin(), tail.begin() + remaining, output + wholeSteps * numLanes);
+        }
+    }
+
+    //==============================================================================
+    // Pink filter state is per channel, so each channel owns one
+    struct PinkFilter
+    {
+        void reset() { b0 = b1 = b2 = 0.0f; }
+
+        void process(float* samples, int numSamples)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const float white = samples[i];
+                b0 = 0.99765f * b0 + white * 0.0990460f;
+                b1 = 0.96300f * b1 + white * 0.2965164f;
+                b2 = 0.57000f * b2 + white * 1.0526913f;
+                samples[i] = (b0 + b1 + b2 + white * 0.1848f) * 0.25f;
+            }
+        }
+
+        float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+    };
+
+private:
+    static constexpr int numLanes = 4;
+
+    void nextStep(float* output)
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            auto x = lanes[static_cast<size_t>(lane)];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            lanes[static_cast<size_t>(lane)] = x;
+
+            // Top 24 bits to [0, 2), then centre
+            output[lane] = static_cast<float>(x >> 8) * (1.0f / 8388608.0f) - 1.0f;
+        }
+    }
+
+    std::array<juce::uint32, numLanes> lanes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NoiseGenerator)
+};
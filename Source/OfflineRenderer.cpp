@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.cpp
+
+    Offline rendering through a private synthesiser.
+
+  ==============================================================================
+*/
+
+#include "OfflineRenderer.h"
+#include "PluginProcessor.h"
+#include "WavetableVoice.h"
+#include "WavetableSound.h"
+
+//==============================================================================
+OfflineRenderer::OfflineRenderer(DUMUMUB003AudioProcessor& processor, const ExpressionSettings& expression,
+                                 WavetableZoneMap& zones, const std::atomic<bool>& multiTimbral)
+    : synthesiser(expression, zones, WavetableZoneMap::offlineReader),
+      zoneMap(zones)
+{
+    for (int i = 0; i < numVoices; ++i)
+        synthesiser.addVoice(new WavetableVoice(processor, true));
+    for (int part = 0; part < DUMUMUB003AudioProcessor::numParts; ++part)
+        synthesiser.addSound(new WavetableSound(part, multiTimbral));
+}
+
+void OfflineRenderer::render(const juce::MidiBuffer& midi, juce::AudioBuffer<float>& output, double sampleRate,
+                             const juce::CriticalSection& sourceLock)
+{
+    synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+    synthesiser.allNotesOff(0, false);
+    output.clear();
+
+    const int numSamples = output.getNumSamples();
+    juce::MidiBuffer blockMidi;
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        const int count = juce::jmin(blockSize, numSamples - start);
+
+        // Slice the events for this block and shift them to block-relative positions
+        blockMidi.clear();
+        blockMidi.addEvents(midi, start, count, -start);
+
+        juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), output.getNumChannels(), start, count);
+        const juce::ScopedLock sl(sourceLock);
+        zoneMap.acquire(WavetableZoneMap::offlineReader);
+        synthesiser.renderNextBlock(block, blockMidi, 0, count);
+        zoneMap.release(WavetableZoneMap::offlineReader);
+    }
+
+    synthesiser.allNotesOff(0, false);
+}
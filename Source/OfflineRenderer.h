@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    OfflineRenderer.h
+
+    Faster-than-realtime rendering through a private copy of the synth engine.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WavetableSynthesiser.h"
+
+class DUMUMUB003AudioProcessor;
+
+//==============================================================================
+/**
+ * Offline Renderer - Private Synthesiser for Background Renders
+ *
+ * Owns its own synthesiser, voices and sounds, reading the same patch as the
+ * live engine but sharing no voice or render state with it, so a render on
+ * a background thread never steals a live voice or touches the audio thread.
+ */
+class OfflineRenderer
+{
+public:
+    static constexpr int numVoices = 16;
+    static constexpr int blockSize = 512;
+
+    OfflineRenderer(DUMUMUB003AudioProcessor& processor, const ExpressionSettings& expression,
+                    WavetableZoneMap& zones, const std::atomic<bool>& multiTimbral);
+
+    // Render the given MIDI into output (cleared first), as fast as the thread allows. The source
+    // lock is held around each block, keeping the granular source in place while voices read it.
+    void render(const juce::MidiBuffer& midi, juce::AudioBuffer<float>& output, double sampleRate,
+                const juce::CriticalSection& sourceLock);
+
+private:
+    WavetableSynthesiser synthesiser;
+    WavetableZoneMap& zoneMap;      // Pinned per block, like the live engine's
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineRenderer)
+};
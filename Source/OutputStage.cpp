@@ -0,0 +1,218 @@
+/*
+  ==============================================================================
+
+    OutputStage.cpp
+
+    Soft clipper and true-peak lookahead limiter implementation.
+
+  ==============================================================================
+*/
+
+#include "OutputStage.h"
+
+//==============================================================================
+namespace
+{
+    // Clipper is linear up to the knee and saturates towards 1.0 above it
+    constexpr float clipperKnee = 0.7f;
+    constexpr float clipperRange = 8.0f;     // Table span in units of (1 - knee) above the knee
+    constexpr int clipperTableSize = 512;
+
+    const std::array<float, clipperTableSize + 1>& getClipperTable()
+    {
+        static const std::array<float, clipperTableSize + 1> table = []
+        {
+            std::array<float, clipperTableSize + 1> t;
+            for (int i = 0; i <= clipperTableSize; ++i)
+                t[i] = clipperKnee + (1.0f - clipperKnee) * std::tanh(clipperRange * (float) i / (float) clipperTableSize);
+            return t;
+        }();
+
+        return table;
+    }
+}
+
+//==============================================================================
+OutputStage::OutputStage()
+{
+    // Build the shared clipper table up front so it is never built on the audio thread
+    getClipperTable();
+}
+
+void OutputStage::prepare(double sampleRate, int maximumBlockSize)
+{
+    currentSampleRate = sampleRate;
+    lookahead = juce::jmax(1, juce::roundToInt(lookaheadSeconds * sampleRate));
+    latency = lookahead - 1 + detectorDelay;
+    chunkSize = juce::jmax(32, maximumBlockSize);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        delays[channel].allocate(latency + chunkSize);
+        detectors[channel].prepare(chunkSize);
+    }
+
+    peaks.assign(static_cast<size_t>(chunkSize), 0.0f);
+    gains.assign(static_cast<size_t>(chunkSize), 1.0f);
+    delayed.assign(static_cast<size_t>(chunkSize), 0.0f);
+    minimumQueue.assign(static_cast<size_t>(lookahead), { 0, 1.0f });
+    averageWindow.assign(static_cast<size_t>(lookahead), 1.0f);
+
+    reset();
+}
+
+void OutputStage::reset()
+{
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        delays[channel].clear();
+        detectors[channel].reset();
+    }
+
+    std::fill(averageWindow.begin(), averageWindow.end(), 1.0f);
+    averageSum = lookahead;
+    averageIndex = 0;
+    queueHead = queueSize = 0;
+    envelope = 1.0f;
+    samplesSinceReduction = 2 * lookahead;
+    idle = true;
+}
+
+//==============================================================================
+void OutputStage::process(juce::AudioBuffer<float>& buffer)
+{
+    const int channels = juce::jmin(numChannels, buffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+
+    if (clipperEnabled)
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            if (buffer.getMagnitude(channel, 0, numSamples) > clipperKnee)
+                clip(buffer.getWritePointer(channel), numSamples);
+    }
+
+    const bool limiterOn = limiterEnabled;
+    if (limiterOn && !wasLimiterEnabled)
+        reset();
+    wasLimiterEnabled = limiterOn;
+
+    if (!limiterOn)
+        return;
+
+    const float threshold = juce::Decibels::decibelsToGain(ceiling.load());
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const int count = juce::jmin(chunkSize, numSamples - start);
+
+        // Sample peaks can hide inter-sample overs of a few dB, so only skip well under the ceiling
+        float blockPeak = 0.0f;
+        for (int channel = 0; channel < channels; ++channel)
+            blockPeak = juce::jmax(blockPeak, buffer.getMagnitude(channel, start, count));
+
+        if (idle && blockPeak < threshold * 0.5f)
+            delayOnly(buffer, channels, start, count);
+        else
+            limit(buffer, channels, start, count);
+    }
+}
+
+void OutputStage::clip(float* samples, int numSamples) const
+{
+    const auto& table = getClipperTable();
+    const float scale = clipperTableSize / (clipperRange * (1.0f - clipperKnee));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float magnitude = std::abs(samples[i]);
+        if (magnitude <= clipperKnee)
+            continue;
+
+        const float position = juce::jmin((magnitude - clipperKnee) * scale, (float) clipperTableSize - 1.0f);
+        const int index = static_cast<int>(position);
+        const float fraction = position - index;
+        const float shaped = table[index] + fraction * (table[index + 1] - table[index]);
+
+        samples[i] = samples[i] < 0.0f ? -shaped : shaped;
+    }
+}
+
+void OutputStage::delayOnly(juce::AudioBuffer<float>& buffer, int channels, int start, int numSamples)
+{
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        float* samples = buffer.getWritePointer(channel, start);
+
+        // Keep the interpolator history current for when detection resumes
+        detectors[channel].skip(samples, numSamples);
+
+        delays[channel].writeBlock(samples, numSamples);
+        delays[channel].readBlock(samples, latency + numSamples, numSamples);
+    }
+
+    sampleCounter += numSamples;
+}
+
+void OutputStage::limit(juce::AudioBuffer<float>& buffer, int channels, int start, int numSamples)
+{
+    const float threshold = juce::Decibels::decibelsToGain(ceiling.load());
+    const float releaseCoefficient = 1.0f - std::exp(-1.0f / (release * 0.001f * static_cast<float>(currentSampleRate)));
+
+    // True-peak detection, vectorised over the block: max of the two neighbouring samples
+    // and three interpolated positions between them, across all channels
+    juce::FloatVectorOperations::clear(peaks.data(), numSamples);
+
+    for (int channel = 0; channel < channels; ++channel)
+        detectors[channel].accumulate(buffer.getReadPointer(channel, start), numSamples, peaks.data());
+
+    // Gain: hold the lowest required gain across the lookahead, then average it over the
+    // same window so the reduction ramps in and is complete as the peak leaves the delay
+    const int capacity = lookahead;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float peak = peaks[static_cast<size_t>(i)];
+        const float required = peak > threshold ? threshold / peak : 1.0f;
+        samplesSinceReduction = required < 1.0f ? 0 : samplesSinceReduction + 1;
+
+        // Expire the oldest entry first so the queue never holds more than the window
+        if (queueSize > 0 && minimumQueue[static_cast<size_t>(queueHead)].index <= sampleCounter - lookahead)
+        {
+            queueHead = (queueHead + 1) % capacity;
+            --queueSize;
+        }
+
+        while (queueSize > 0 && minimumQueue[static_cast<size_t>((queueHead + queueSize - 1) % capacity)].gain >= required)
+            --queueSize;
+        minimumQueue[static_cast<size_t>((queueHead + queueSize) % capacity)] = { sampleCounter, required };
+        ++queueSize;
+
+        const float held = minimumQueue[static_cast<size_t>(queueHead)].gain;
+        averageSum += held - averageWindow[static_cast<size_t>(averageIndex)];
+        averageWindow[static_cast<size_t>(averageIndex)] = held;
+        averageIndex = (averageIndex + 1) % capacity;
+
+        const float target = static_cast<float>(averageSum / lookahead);
+        envelope = target < envelope ? target : envelope + releaseCoefficient * (target - envelope);
+        gains[static_cast<size_t>(i)] = envelope;
+
+        ++sampleCounter;
+    }
+
+    // Apply the gain to the delayed signal
+    for (int channel = 0; channel < channels; ++channel)
+    {
+        float* samples = buffer.getWritePointer(channel, start);
+        delays[channel].writeBlock(samples, numSamples);
+        delays[channel].readBlock(delayed.data(), latency + numSamples, numSamples);
+        juce::FloatVectorOperations::multiply(samples, delayed.data(), gains.data(), numSamples);
+    }
+
+    // Go idle once the window is clear and the release has finished
+    idle = samplesSinceReduction >= 2 * lookahead && envelope > 0.9999f;
+    if (idle)
+    {
+        envelope = 1.0f;
+        averageSum = lookahead;
+    }
+}
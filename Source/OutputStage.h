@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    OutputStage.h
+
+    Final output protection for DUMUMUB wavetable synthesizer.
+    Table-driven soft clipper followed by a true-peak lookahead limiter.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayLine.h"
+#include "TruePeakDetector.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Output Stage - Soft Clipper and True-Peak Lookahead Limiter
+ *
+ * The soft clipper is linear below its knee and follows a tanh curve from a
+ * shared lookup table above it; blocks that stay under the knee are skipped.
+ *
+ * The limiter estimates inter-sample peaks with a 4x polyphase interpolator,
+ * holds the minimum required gain across the lookahead window and smooths it
+ * with a moving average, so gain reduction is fully in place when the peak
+ * leaves the delay. Detection and gain are vector operations over the block.
+ * While the limiter is idle and a block stays well under the ceiling, only
+ * the lookahead delay runs.
+ */
+class OutputStage
+{
+public:
+    static constexpr double lookaheadSeconds = 0.0015;
+
+    OutputStage();
+
+    void prepare(double sampleRate, int maximumBlockSize);
+    void process(juce::AudioBuffer<float>& buffer);
+
+    // Latency added by the limiter (0 while it is disabled)
+    int getLatencySamples() const { return limiterEnabled ? latency : 0; }
+
+    void setLimiterEnabled(bool shouldBeEnabled) { limiterEnabled = shouldBeEnabled; }
+    bool isLimiterEnabled() const { return limiterEnabled; }
+    void setCeiling(float decibels) { ceiling = juce::jlimit(-12.0f, 0.0f, decibels); }
+    float getCeiling() const { return ceiling; }
+    void setRelease(float milliseconds) { release = juce::jlimit(5.0f, 1000.0f, milliseconds); }
+    float getRelease() const { return release; }
+
+    void setClipperEnabled(bool shouldBeEnabled) { clipperEnabled = shouldBeEnabled; }
+    bool isClipperEnabled() const { return clipperEnabled; }
+
+private:
+    // True-peak detection runs this many samples behind the input
+    static constexpr int detectorDelay = TruePeakDetector::delay;
+    static constexpr int numChannels = 2;
+
+    void clip(float* samples, int numSamples) const;
+    void limit(juce::AudioBuffer<float>& buffer, int channels, int start, int numSamples);
+    void delayOnly(juce::AudioBuffer<float>& buffer, int channels, int start, int numSamples);
+    void reset();
+
+    double currentSampleRate = 44100.0;
+    int lookahead = 66;
+    int latency = 69;
+    int chunkSize = 512;
+
+    // Per-channel delay and true-peak detector
+    std::array<DelayLine, numChannels> delays;
+    std::array<TruePeakDetector, numChannels> detectors;
+
+    // Block scratch
+    std::vector<float> peaks;
+    std::vector<float> gains;
+    std::vector<float> delayed;
+
+    // Sliding minimum (monotonic queue) and moving average of that minimum
+    struct QueuedGain
+    {
+        juce::int64 index;
+        float gain;
+    };
+    std::vector<QueuedGain> minimumQueue;
+    int queueHead = 0;
+    int queueSize = 0;
+    std::vector<float> averageWindow;
+    int averageIndex = 0;
+    double averageSum = 0.0;
+    juce::int64 sampleCounter = 0;
+    float envelope = 1.0f;
+    int samplesSinceReduction = 0;
+    bool idle = true;
+    bool wasLimiterEnabled = false;
+
+    std::atomic<bool> limiterEnabled { false };   // Opt-in: it adds latency and changes the sound of existing projects
+    std::atomic<bool> clipperEnabled { false };
+    std::atomic<float> ceiling { -0.3f };
+    std::atomic<float> release { 80.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutputStage)
+};
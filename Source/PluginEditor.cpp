@@ -31,7 +31,10 @@ DUMUMUB003AudioProcessorEditor::DUMUMUB003AudioProcessorEditor (DUMUMUB003AudioP
       audioButton(p),
       imageButton(p),
       volumeDisplay(p),
-      canvas(p)
+      canvas(p),
+      enginePanel(p),
+      loudnessDisplay(p),
+      voiceStatsDisplay(p)
 {
     // Set plugin window dimensions
     setSize (width, height);
@@ -46,6 +49,20 @@ DUMUMUB003AudioProcessorEditor::DUMUMUB003AudioProcessorEditor (DUMUMUB003AudioP
     addAndMakeVisible(canvasBorder);
     canvasBorder.toFront(true);
 
+    // Engine panel covers the canvas while the ENGINE button in the bottom strip is on
+    enginePanel.setBounds(38, 238, 1024, 500);
+    addChildComponent(enginePanel);
+
+    enginePanel.onPatchChanged = [this] { refreshPatchControls(); };
+
+    engineButton.setBounds(38, artworkHeight + 5, 90, 20);
+    engineButton.setClickingTogglesState(true);
+    engineButton.onClick = [this] { enginePanel.setVisible(engineButton.getToggleState()); };
+    addAndMakeVisible(engineButton);
+
+    loudnessDisplay.setBounds(140, artworkHeight + 5, 420, 20);
+    addAndMakeVisible(loudnessDisplay);
+
     // Setup UI buttons with state restoration
     titleButton = std::make_unique<TitleButton>(p);
     titleButton->setBounds(55, 10, 530, 80);
@@ -198,6 +215,10 @@ DUMUMUB003AudioProcessorEditor::DUMUMUB003AudioProcessorEditor (DUMUMUB003AudioP
     // Setup volume level display
     volumeDisplay.setBounds(610, 40, 335, 50);
     addAndMakeVisible(volumeDisplay);
+
+    // Setup voice statistics in the status strip, right of the loudness readout
+    voiceStatsDisplay.setBounds(570, artworkHeight + 5, 492, 20);
+    addAndMakeVisible(voiceStatsDisplay);
 }
 
 DUMUMUB003AudioProcessorEditor::~DUMUMUB003AudioProcessorEditor()
@@ -226,8 +247,12 @@ void DUMUMUB003AudioProcessorEditor::paint (juce::Graphics& g)
     // Render scaled background image to fit plugin window
     if (!background.isNull())
     {
-        g.drawImage(background, 0, 0, 1100, 776, 0, 0, background.getWidth(), background.getHeight());
+        g.drawImage(background, 0, 0, width, artworkHeight, 0, 0, background.getWidth(), background.getHeight());
     }
+
+    // Status strip under the artwork
+    g.setColour(black);
+    g.fillRect(0, artworkHeight, width, height - artworkHeight);
 }
 
 void DUMUMUB003AudioProcessorEditor::resized()
@@ -270,6 +295,21 @@ void DUMUMUB003AudioProcessorEditor::buttonClicked(juce::Button* button)
     // Button click handling delegated to individual button components
 }
 
+void DUMUMUB003AudioProcessorEditor::refreshPatchControls()
+{
+    // The processor's patch was replaced wholesale: show its gain, envelope and tables
+    const float gain = audioProcessor.getGain();
+    gainSlider.setValue(gain > 0.0f ? juce::Decibels::gainToDecibels(gain) : -36.0, juce::dontSendNotification);
+
+    const auto params = audioProcessor.getADSRParameters();
+    attackSlider.setValue(params.attack, juce::dontSendNotification);
+    decaySlider.setValue(params.decay, juce::dontSendNotification);
+    sustainSlider.setValue(params.sustain, juce::dontSendNotification);
+    releaseSlider.setValue(params.release, juce::dontSendNotification);
+
+    canvas.repaint();
+}
+
 // Wavetable manipulation interface methods
 void DUMUMUB003AudioProcessorEditor::setWaveTableL(int index, float value)
 {
@@ -28,6 +28,9 @@
 #include "HelpScreen.h"
 #include "SliderLookAndFeel.h"
 #include "VolumeDisplay.h"
+#include "VoiceStatsDisplay.h"
+#include "LoudnessDisplay.h"
+#include "EnginePanel.h"
 #include "KnobBackground.h"
 
 // Forward declarations
@@ -83,6 +86,7 @@ public:
 
     void toggleHelp(bool value){ helpScreen.toggle(value); }
     void repaintCanvas(){ canvas.repaint(); }
+    void refreshPatchControls();
 
     // File Display Management
     void setAudioFileName(String name){ fileDisplayAUDIO.setFileName(name); }
@@ -94,12 +98,20 @@ private:
     //==============================================================================
     // UI Layout Constants
     int width = 1100;
-    int height = 776;
+    int height = 806;
+    int artworkHeight = 776;    // The background artwork; the strip below it holds the status and engine controls
 
     // Main Visualization
     Canvas canvas;
     CanvasBorder canvasBorder;
 
+    // Engine Settings (overlays the canvas)
+    EnginePanel enginePanel;
+    TextButton engineButton { "ENGINE" };
+
+    // Status Strip
+    LoudnessDisplay loudnessDisplay;
+
     // Navigation & Control Buttons
     std::unique_ptr<TitleButton> titleButton;
     std::unique_ptr<LeftButton> leftButton;
@@ -152,6 +164,8 @@ private:
     KnobBackground knobsBackground;
     SliderLookAndFeel sliderLookAndFeel;
     VolumeDisplay volumeDisplay;
+    VoiceStatsDisplay voiceStatsDisplay;
+    juce::TooltipWindow tooltipWindow { this };
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DUMUMUB003AudioProcessorEditor)
 };
@@ -23,6 +23,8 @@ DUMUMUB003AudioProcessor::DUMUMUB003AudioProcessor()
                      #if ! JucePlugin_IsMidiEffect
                       #if ! JucePlugin_IsSynth
                        .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #else
+                       .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)
                       #endif
                        .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                      #endif
@@ -34,20 +36,50 @@ DUMUMUB003AudioProcessor::DUMUMUB003AudioProcessor()
 
     gain = 1.0f;
 
-    loudnessL = 0.0f;
-    loudnessR = 0.0f;
+    for (auto& note : heldNotes)
+        note = 0;
+
+    for (auto& shape : analyticShapes)
+        shape = static_cast<int>(AnalyticOscillator::Shape::none);
 
     // Initialize wavetable arrays
     waveTableL.fill(0.0);
     waveTableR.fill(0.0);
 
-    currentWaveBufferTableL.fill(0.0);
-    currentWaveBufferTableR.fill(0.0);
-
-    // Setup polyphonic synthesizer with 8 voices
-    for (int i = 0; i < 8; ++i) // Add 8 voices for polyphony
+    // Setup one shared voice pool and a sound per multi-timbral part
+    for (int i = 0; i < numVoices; ++i)
             synthesiser.addVoice(new WavetableVoice(*this));
-    synthesiser.addSound(new WavetableSound());
+    for (int part = 0; part < numParts; ++part)
+        synthesiser.addSound(new WavetableSound(part, multiTimbral));
+
+    for (auto& part : parts)
+    {
+        part.waveTableL.fill(0.0f);
+        part.waveTableR.fill(0.0f);
+    }
+
+    // Build rate-independent template tables up front so restored state is never overwritten
+    fillSineWavetable();
+    fillSquareWavetable();
+    fillTriangleWavetable();
+    fillSawtoothWavetable();
+    fillAudioWavetables();
+    fillImageWavetable();
+
+    // Set default sine wave for both channels
+    copyWaveTableToL(sineWave);
+    copyWaveTableToR(sineWave);
+
+    // Partials for the default tables; later edits are picked up by the timer
+    spectrumScratch.assign(AdditiveOscillator::frameSize * 2, 0.0f);
+    analyseTableSpectra();
+    analysedSpectraVersion = tableVersion.load();
+
+    // Build the shared grain window up front so no voice ever does it on the audio thread
+    GrainWindow::get();
+
+    // Likewise the trace recorder, whose first use constructs its flush thread
+    TraceRecorder::getInstance();
 
     // Initialize ADSR parameters with default values
     adsrParams.attack = 0.1f;
@@ -55,17 +87,23 @@ DUMUMUB003AudioProcessor::DUMUMUB003AudioProcessor()
     adsrParams.sustain = 1.0f;
     adsrParams.release = 0.1f;
 
-    // Initialize selected waves map with default values
-    selectedWaves["sine"] = false;
-    selectedWaves["square"] = false;
-    selectedWaves["triangle"] = false;
-    selectedWaves["saw"] = false;
-    selectedWaves["audio"] = false;
-    selectedWaves["image"] = false;
+    // No waveforms selected by default
+    for (auto& selected : selectedWaves)
+        selected = false;
+
+    // Expose the engine settings to the host and the editor's engine panel
+    createParameters();
+
+    // Watch for idle time, pending reloads and captured cycles from the message thread
+    startTimerHz(30);
 }
 
 DUMUMUB003AudioProcessor::~DUMUMUB003AudioProcessor()
 {
+    // Finish any in-flight rebuild before the data it writes to is destroyed
+    stopTimer();
+    backgroundWorker.stop();
+    longJobWorker.stop();
 }
 
 //==============================================================================
@@ -133,30 +171,603 @@ void DUMUMUB003AudioProcessor::changeProgramName (int index, const juce::String&
 //==============================================================================
 void DUMUMUB003AudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    // Initialize wavetables on first playback preparation
-    if (!waveTablesInitialized)
+    // Configure synthesizer sample rate (voices rescale their envelopes immediately)
+    synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+
+    // Voice tuning and smoothing data is built synchronously only the first time. Afterwards
+    // it is rebuilt in the background while voices compensate from the previous snapshot.
+    // The stages below it still prepare here, on the calling thread.
+    if (!rateData.hasData())
+        rateData.buildNow(sampleRate, samplesPerBlock);
+    else
+        rateData.requestRebuild(sampleRate, samplesPerBlock);
+
+    // Bring back anything freed while the host had us released. Always posted: the suspend
+    // from releaseResources may still be queued, and posting under the same key replaces it.
+    idleSamples = 0;
+    requestResume();
+
+    // The impulse is resampled to the playback rate
+    requestConvolutionRebuild();
+
+    // Effect delay lines are sized here so the audio thread never allocates
+    effects.prepare(sampleRate, samplesPerBlock);
+
+    // Limiter lookahead depends on the rate, so report latency after preparing it
+    outputStage.prepare(sampleRate, samplesPerBlock);
+    setLatencySamples(outputStage.getLatencySamples());
+    loudnessMeter.prepare(sampleRate, samplesPerBlock);
+    processTiming.prepare(sampleRate);
+    voiceStats.prepare(sampleRate);
+
+    // Pitch tracking range depends on the rate
+    liveCapture.prepare(sampleRate);
+}
+
+void DUMUMUB003AudioProcessor::releaseResources()
+{
+    // Free the dropped files until the host prepares us again
+    requestSuspend(true);
+}
+
+//==============================================================================
+void DUMUMUB003AudioProcessor::timerCallback()
+{
+    // Automation of settings that must not change on the audio thread
+    hostParameters.applyPending();
+
+    // Apply a finished bounce here, the same way editor actions change the tables
+    if (bounceReady)
     {
-        fillSineWavetable();
-        fillSquareWavetable();
-        fillTriangleWavetable();
-        fillSawtoothWavetable();
-        fillAudioWavetables();
-        fillImageWavetable();
+        const juce::ScopedLock sl(bounceLock);
+        copyWaveTableToL(bounceTableL);
+        copyWaveTableToR(bounceTableR);
+        bounceReady = false;
+    }
 
-        // Set default sine wave for both channels
-        copyWaveTableToL(sineWave);
-        copyWaveTableToR(sineWave);
+    // Likewise for tables derived from files reloaded after a state restore
+    if (reloadedAudioReady || reloadedImageReady)
+    {
+        const juce::ScopedLock sl(reloadLock);
+        if (reloadedAudioReady.exchange(false))
+        {
+            audioWaveL = reloadedAudioL;
+            audioWaveR = reloadedAudioR;
+        }
+        if (reloadedImageReady.exchange(false))
+            imageWave = reloadedImage;
+    }
 
-        waveTablesInitialized = true;
+    // And for the newest live-captured cycle
+    if (liveCapture.isEnabled())
+    {
+        std::array<float, 1024> capturedL, capturedR;
+        if (liveCapture.collect(capturedL, capturedR))
+        {
+            copyWaveTableToL(capturedL);
+            copyWaveTableToR(capturedR);
+        }
     }
 
-    // Configure synthesizer sample rate
-    synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+    if (classifiedVersion != tableVersion)
+    {
+        DUMUMUB_TRACE_SCOPE ("tables", "classifyTables");
+        classifyAnalyticShapes();
+    }
+
+    // Spectra wait while the audio thread still holds the spare bank, or a bounce reads the live one
+    const auto version = tableVersion.load();
+    if (analysedSpectraVersion != version && !bouncing)
+    {
+        DUMUMUB_TRACE_SCOPE ("tables", "analyseSpectra");
+        if (analyseTableSpectra())
+            analysedSpectraVersion = version;
+    }
+
+    const bool active = activitySeen.exchange(false);
+
+    if (suspended)
+    {
+        if (active)
+            requestResume();
+    }
+    else if (idleSuspendSeconds > 0.0f && getSampleRate() > 0.0
+             && idleSamples > static_cast<juce::int64>(idleSuspendSeconds * getSampleRate()))
+    {
+        requestSuspend(false);
+    }
 }
 
-void DUMUMUB003AudioProcessor::releaseResources()
+void DUMUMUB003AudioProcessor::createParameters()
+{
+    // Oscillator mode and granular controls
+    hostParameters.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "oscillatorMode", 1 }, "Oscillator Mode",
+                                                                    juce::StringArray { "Wavetable", "Granular", "Additive" }, 0),
+                       [this] (float value) { setOscillatorMode(static_cast<OscillatorMode>(juce::roundToInt(value))); },
+                       [this] { return static_cast<float>(getOscillatorMode()); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "grainPosition", 1 }, "Grain Position",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.5f),
+                       [this] (float value) { setGrainPosition(value); },
+                       [this] { return grainPosition.load(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "grainSize", 1 }, "Grain Size",
+                                                                   juce::NormalisableRange<float> (5.0f, 1000.0f, 0.0f, 0.4f), 80.0f),
+                       [this] (float value) { setGrainSize(value); },
+                       [this] { return grainSize.load(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "grainDensity", 1 }, "Grain Density",
+                                                                   juce::NormalisableRange<float> (0.5f, 500.0f, 0.0f, 0.3f), 20.0f),
+                       [this] (float value) { setGrainDensity(value); },
+                       [this] { return grainDensity.load(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "grainSpray", 1 }, "Grain Spray",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.1f),
+                       [this] (float value) { setGrainSpray(value); },
+                       [this] { return grainSpray.load(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "grainPitch", 1 }, "Grain Pitch",
+                                                                   juce::NormalisableRange<float> (-48.0f, 48.0f), 0.0f),
+                       [this] (float value) { setGrainPitch(value); },
+                       [this] { return grainPitch.load(); });
+
+    // Multi-timbral mode (switching it can turn MPE off, so the host sees both)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "multiTimbral", 1 }, "Multi-Timbral", false),
+                       [this] (float value) { setMultiTimbral(value >= 0.5f); hostParameters.pullFromEngine(); },
+                       [this] { return isMultiTimbral() ? 1.0f : 0.0f; },
+                       HostParameters::Thread::message);
+
+    // Pitch bend and MPE (enabling MPE can turn multi-timbral mode off, as above)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "mpeEnabled", 1 }, "MPE", false),
+                       [this] (float value) { setMPEEnabled(value >= 0.5f); hostParameters.pullFromEngine(); },
+                       [this] { return isMPEEnabled() ? 1.0f : 0.0f; },
+                       HostParameters::Thread::message);
+    hostParameters.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "mpeZone", 1 }, "MPE Zone",
+                                                                    juce::StringArray { "Lower", "Upper" }, 0),
+                       [this] (float value) { setMPEZone(juce::roundToInt(value) == 0); },
+                       [this] { return expression.mpeMasterChannel.load() == 1 ? 0.0f : 1.0f; });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "pitchBendRange", 1 }, "Bend Range",
+                                                                   juce::NormalisableRange<float> (0.0f, 96.0f, 1.0f), 2.0f),
+                       [this] (float value) { setPitchBendRange(value); },
+                       [this] { return expression.pitchBendRange.load(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "mpeNoteBendRange", 1 }, "Note Bend Range",
+                                                                   juce::NormalisableRange<float> (0.0f, 96.0f, 1.0f), 48.0f),
+                       [this] (float value) { setMPENoteBendRange(value); },
+                       [this] { return expression.mpeNoteBendRange.load(); });
+
+    // Idle suspend (0 keeps the dropped files loaded)
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "idleSuspendSeconds", 1 }, "Idle Suspend",
+                                                                   juce::NormalisableRange<float> (0.0f, 600.0f, 1.0f, 0.4f), 0.0f),
+                       [this] (float value) { setIdleSuspendSeconds(value); },
+                       [this] { return getIdleSuspendSeconds(); });
+
+    // Convolution (enabling it posts an impulse rebuild)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "convolutionEnabled", 1 }, "Convolution", false),
+                       [this] (float value) { setConvolutionEnabled(value >= 0.5f); },
+                       [this] { return isConvolutionEnabled() ? 1.0f : 0.0f; },
+                       HostParameters::Thread::message);
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "convolutionMix", 1 }, "Convolution Mix",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.35f),
+                       [this] (float value) { setConvolutionMix(value); },
+                       [this] { return getConvolutionMix(); });
+
+    // Effects bus
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "chorusEnabled", 1 }, "Chorus", false),
+                       [this] (float value) { effects.setEnabled(EffectsChain::chorus, value >= 0.5f); },
+                       [this] { return effects.isEnabled(EffectsChain::chorus) ? 1.0f : 0.0f; });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "chorusRate", 1 }, "Chorus Rate",
+                                                                   juce::NormalisableRange<float> (0.05f, 10.0f, 0.0f, 0.4f), 0.8f),
+                       [this] (float value) { effects.getChorus().setRate(value); },
+                       [this] { return effects.getChorus().getRate(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "chorusDepth", 1 }, "Chorus Depth",
+                                                                   juce::NormalisableRange<float> (0.0f, 5.0f), 2.5f),
+                       [this] (float value) { effects.getChorus().setDepth(value); },
+                       [this] { return effects.getChorus().getDepth(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "chorusMix", 1 }, "Chorus Mix",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.5f),
+                       [this] (float value) { effects.getChorus().setMix(value); },
+                       [this] { return effects.getChorus().getMix(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "delayEnabled", 1 }, "Delay", false),
+                       [this] (float value) { effects.setEnabled(EffectsChain::delay, value >= 0.5f); },
+                       [this] { return effects.isEnabled(EffectsChain::delay) ? 1.0f : 0.0f; });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "delayTimeLeft", 1 }, "Delay Left",
+                                                                   juce::NormalisableRange<float> (10.0f, StereoDelayEffect::maximumDelayMilliseconds, 0.0f, 0.5f), 375.0f),
+                       [this] (float value) { effects.getDelay().setTime(0, value); },
+                       [this] { return effects.getDelay().getTime(0); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "delayTimeRight", 1 }, "Delay Right",
+                                                                   juce::NormalisableRange<float> (10.0f, StereoDelayEffect::maximumDelayMilliseconds, 0.0f, 0.5f), 500.0f),
+                       [this] (float value) { effects.getDelay().setTime(1, value); },
+                       [this] { return effects.getDelay().getTime(1); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "delayFeedback", 1 }, "Delay Feedback",
+                                                                   juce::NormalisableRange<float> (0.0f, 0.95f), 0.35f),
+                       [this] (float value) { effects.getDelay().setFeedback(value); },
+                       [this] { return effects.getDelay().getFeedback(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "delayMix", 1 }, "Delay Mix",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.3f),
+                       [this] (float value) { effects.getDelay().setMix(value); },
+                       [this] { return effects.getDelay().getMix(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "reverbEnabled", 1 }, "Reverb", false),
+                       [this] (float value) { effects.setEnabled(EffectsChain::reverb, value >= 0.5f); },
+                       [this] { return effects.isEnabled(EffectsChain::reverb) ? 1.0f : 0.0f; });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "reverbSize", 1 }, "Reverb Size",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.5f),
+                       [this] (float value) { effects.getReverb().setSize(value); },
+                       [this] { return effects.getReverb().getSize(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "reverbDamping", 1 }, "Reverb Damping",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.3f),
+                       [this] (float value) { effects.getReverb().setDamping(value); },
+                       [this] { return effects.getReverb().getDamping(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "reverbPredelay", 1 }, "Reverb Predelay",
+                                                                   juce::NormalisableRange<float> (0.0f, 200.0f), 10.0f),
+                       [this] (float value) { effects.getReverb().setPredelay(value); },
+                       [this] { return effects.getReverb().getPredelay(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "reverbMix", 1 }, "Reverb Mix",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.25f),
+                       [this] (float value) { effects.getReverb().setMix(value); },
+                       [this] { return effects.getReverb().getMix(); });
+
+    // Output protection (the limiter changes the reported latency)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "limiterEnabled", 1 }, "Limiter", false),
+                       [this] (float value) { setLimiterEnabled(value >= 0.5f); },
+                       [this] { return isLimiterEnabled() ? 1.0f : 0.0f; },
+                       HostParameters::Thread::message);
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "limiterCeiling", 1 }, "Limiter Ceiling",
+                                                                   juce::NormalisableRange<float> (-12.0f, 0.0f), -0.3f),
+                       [this] (float value) { setLimiterCeiling(value); },
+                       [this] { return getLimiterCeiling(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "limiterRelease", 1 }, "Limiter Release",
+                                                                   juce::NormalisableRange<float> (5.0f, 1000.0f, 0.0f, 0.4f), 80.0f),
+                       [this] (float value) { setLimiterRelease(value); },
+                       [this] { return getLimiterRelease(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "softClipperEnabled", 1 }, "Soft Clipper", false),
+                       [this] (float value) { setSoftClipperEnabled(value >= 0.5f); },
+                       [this] { return isSoftClipperEnabled() ? 1.0f : 0.0f; });
+
+    // Live capture (starts or stops the analysis thread)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "liveCaptureEnabled", 1 }, "Live Capture", false),
+                       [this] (float value) { setLiveCaptureEnabled(value >= 0.5f); },
+                       [this] { return isLiveCaptureEnabled() ? 1.0f : 0.0f; },
+                       HostParameters::Thread::message);
+
+    // Zone keyswitches (the zones themselves are edited from the engine panel)
+    hostParameters.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID { "keyswitchesEnabled", 1 }, "Keyswitches", false),
+                       [this] (float value) { zones.setKeyswitchesEnabled(value >= 0.5f); },
+                       [this] { return zones.areKeyswitchesEnabled() ? 1.0f : 0.0f; });
+    hostParameters.add(std::make_unique<juce::AudioParameterInt>(juce::ParameterID { "keyswitchBase", 1 }, "Keyswitch Base",
+                                                                 0, 128 - WavetableZoneMap::numSets, 24),
+                       [this] (float value) { zones.setKeyswitchBase(juce::roundToInt(value)); },
+                       [this] { return static_cast<float>(zones.getKeyswitchBase()); });
+
+    // Additive partial shaping
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "additiveTilt", 1 }, "Additive Tilt",
+                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f), 0.0f),
+                       [this] (float value) { setAdditiveTilt(value); },
+                       [this] { return getAdditiveTilt(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "additiveOddEven", 1 }, "Odd/Even",
+                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f), 0.0f),
+                       [this] (float value) { setAdditiveOddEven(value); },
+                       [this] { return getAdditiveOddEven(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "additiveStretch", 1 }, "Stretch",
+                                                                   juce::NormalisableRange<float> (0.0f, 0.01f), 0.0f),
+                       [this] (float value) { setAdditiveStretch(value); },
+                       [this] { return getAdditiveStretch(); });
+
+    // Spectral morph position (writes a precomputed frame into both editor tables)
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "morphPosition", 1 }, "Morph",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                       [this] (float value) { setMorphPosition(value); },
+                       [this] { return getMorphPosition(); },
+                       HostParameters::Thread::message);
+
+    // Cross-modulation operators
+    hostParameters.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "operatorMode", 1 }, "Operator",
+                                                                    juce::StringArray { "Off", "Phase Mod", "Ring Mod" }, 0),
+                       [this] (float value) { setOperatorMode(static_cast<OperatorMode>(juce::roundToInt(value))); },
+                       [this] { return static_cast<float>(getOperatorMode()); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "operatorRatio", 1 }, "Operator Ratio",
+                                                                   juce::NormalisableRange<float> (0.125f, 16.0f, 0.0f, 0.3f), 1.0f),
+                       [this] (float value) { setOperatorRatio(value); },
+                       [this] { return getOperatorRatio(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "operatorIndex", 1 }, "Operator Index",
+                                                                   juce::NormalisableRange<float> (0.0f, 8.0f), 1.0f),
+                       [this] (float value) { setOperatorIndex(value); },
+                       [this] { return getOperatorIndex(); });
+
+    // Sub-oscillator and noise layers
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "subLevel", 1 }, "Sub Level",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                       [this] (float value) { setSubLevel(value); },
+                       [this] { return getSubLevel(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "subOctaves", 1 }, "Sub Octave",
+                                                                    juce::StringArray { "-1 Octave", "-2 Octaves" }, 0),
+                       [this] (float value) { setSubOctaves(juce::roundToInt(value) + 1); },
+                       [this] { return static_cast<float>(getSubOctaves() - 1); });
+    hostParameters.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID { "noiseLevel", 1 }, "Noise Level",
+                                                                   juce::NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                       [this] (float value) { setNoiseLevel(value); },
+                       [this] { return getNoiseLevel(); });
+    hostParameters.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID { "noiseColour", 1 }, "Noise Colour",
+                                                                    juce::StringArray { "White", "Pink", "Sample & Hold" }, 0),
+                       [this] (float value) { setNoiseColour(static_cast<NoiseGenerator::Colour>(juce::roundToInt(value))); },
+                       [this] { return static_cast<float>(getNoiseColour()); });
+}
+
+void DUMUMUB003AudioProcessor::classifyAnalyticShapes()
+{
+    // An edit landing mid-scan bumps the version again, so a stale result is never used
+    const auto version = tableVersion.load();
+
+    for (int part = 0; part < numParts; ++part)
+    {
+        const auto shapeL = AnalyticOscillator::classify(getPartWaveTableL(part), sineWave, squareWave, triangleWave, sawtoothWave);
+        const auto shapeR = AnalyticOscillator::classify(getPartWaveTableR(part), sineWave, squareWave, triangleWave, sawtoothWave);
+        analyticShapes[static_cast<size_t>(part * 2)] = static_cast<int>(shapeL);
+        analyticShapes[static_cast<size_t>(part * 2 + 1)] = static_cast<int>(shapeR);
+    }
+
+    classifiedVersion = version;
+}
+
+bool DUMUMUB003AudioProcessor::analyseTableSpectra()
+{
+    // The audio thread can only pin the published bank, so once it has let go of the other
+    // one that bank is free to rewrite
+    const int target = 1 - publishedSpectra.load();
+    if (spectraInUseByAudioThread.load() == target)
+        return false;
+
+    auto& bank = tableSpectra[static_cast<size_t>(target)];
+    for (int part = 0; part < numParts; ++part)
+    {
+        AdditiveOscillator::analyse(getPartWaveTableL(part), spectrumFFT, spectrumScratch.data(), bank[static_cast<size_t>(part * 2)]);
+        AdditiveOscillator::analyse(getPartWaveTableR(part), spectrumFFT, spectrumScratch.data(), bank[static_cast<size_t>(part * 2 + 1)]);
+    }
+
+    publishedSpectra.store(target);
+    return true;
+}
+
+int DUMUMUB003AudioProcessor::acquireTableSpectra() noexcept
+{
+    // Hazard pointer: re-check after announcing, in case a publish landed in between
+    int bank = publishedSpectra.load();
+    for (;;)
+    {
+        spectraInUseByAudioThread.store(bank);
+        const int latest = publishedSpectra.load();
+        if (latest == bank)
+            return bank;
+        bank = latest;
+    }
+}
+
+void DUMUMUB003AudioProcessor::requestSpectrumAnalysis(const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    // Keyed, so a frame that is still being analysed swallows the next request
+    backgroundWorker.post("spectrum", [this, tableL, tableR]
+    {
+        spectrumAnalyser.analyse(scope, getSampleRate(), tableL, tableR);
+    });
+}
+
+const TableSpectrum& DUMUMUB003AudioProcessor::getTableSpectrum(int partIndex, int channel, bool offline) const
+{
+    const int part = (partIndex > 0 && partIndex < numParts) ? partIndex : 0;
+    const int bank = offline ? publishedSpectra.load() : blockSpectra;
+    return tableSpectra[static_cast<size_t>(bank)][static_cast<size_t>(part * 2 + (channel != 0 ? 1 : 0))];
+}
+
+AnalyticOscillator::Shape DUMUMUB003AudioProcessor::getAnalyticShape(int partIndex, int channel) const
+{
+    if (!analyticEnabled || classifiedVersion != tableVersion || partIndex < 0 || partIndex >= numParts)
+        return AnalyticOscillator::Shape::none;
+
+    return static_cast<AnalyticOscillator::Shape>(analyticShapes[static_cast<size_t>(partIndex * 2 + (channel != 0 ? 1 : 0))].load());
+}
+
+void DUMUMUB003AudioProcessor::requestSuspend(bool force)
+{
+    // Suspend and resume share a key, so whichever was requested last wins
+    backgroundWorker.post("droppedFiles", [this, force]
+    {
+        const juce::ScopedLock sl(droppedFilesLock);
+
+        // A note may have arrived since the idle check
+        if (suspended || (!force && idleSamples == 0))
+            return;
+
+        // Flag first so a note arriving during the free is seen by the next timer tick
+        suspended = true;
+
+        AudioBuffer<float> released;
+        {
+            const juce::SpinLock::ScopedLockType lock(droppedAudioLock);
+            std::swap(released, droppedAudio);
+        }
+
+        // The image wavetable is already derived, so the decoded image is only
+        // needed again when a new image is dropped
+        droppedImage = Image();
+
+        // The convolution partitions are derived from the same buffer
+        convolution.releaseImpulse();
+    });
+}
+
+void DUMUMUB003AudioProcessor::requestFileReload()
+{
+    // Paths are copied here; the worker never touches the members the editor writes
+    backgroundWorker.post("restoreFiles", [this, audioFile = audioPath, imageFile = imagePath]
+    {
+        if (!audioFile.isEmpty())
+        {
+            DUMUMUB_TRACE_SCOPE ("files", "importAudio");
+            const juce::ScopedLock sl(droppedFilesLock);
+
+            if (loadDroppedAudio(audioFile))
+            {
+                const juce::ScopedLock rl(reloadLock);
+                fillAudioWavetableFromAudio(reloadedAudioL, reloadedAudioR);
+                reloadedAudioReady = true;
+
+                suspended = false;
+                requestConvolutionRebuild();
+            }
+        }
+
+        if (!imageFile.isEmpty())
+        {
+            DUMUMUB_TRACE_SCOPE ("files", "importImage");
+            Image image = ImageFileFormat::loadFrom(File(imageFile));
+            if (!image.isNull())
+            {
+                const juce::ScopedLock sl(droppedFilesLock);
+                droppedImage = image;
+
+                const juce::ScopedLock rl(reloadLock);
+                fillImageWavetableFromImage(reloadedImage);
+                reloadedImageReady = true;
+            }
+        }
+    });
+}
+
+void DUMUMUB003AudioProcessor::requestResume()
+{
+    // Copied here: reading the path on the worker would race setAudioPath from the editor
+    backgroundWorker.post("droppedFiles", [this, audioFile = audioPath]
+    {
+        const juce::ScopedLock sl(droppedFilesLock);
+
+        if (!suspended)
+            return;
+
+        // Only the granular source needs the full buffer back
+        if (!audioFile.isEmpty())
+            loadDroppedAudio(audioFile);
+
+        suspended = false;
+        rebuildConvolution();
+    });
+}
+
+bool DUMUMUB003AudioProcessor::bounceToTable(int cyclesToAverage)
+{
+    // Snapshot the held chord
+    juce::MidiBuffer chord;
+    for (int note = 0; note < 128; ++note)
+        if (const auto velocity = heldNotes[static_cast<size_t>(note)].load())
+            chord.addEvent(juce::MidiMessage::noteOn(1, note, velocity), 0);
+
+    if (chord.isEmpty())
+        return false;
+
+    // Long enough to get through attack and decay into the sustain
+    const double rate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    const double seconds = juce::jlimit(0.25, 10.0, static_cast<double>(adsrParams.attack + adsrParams.decay) + 0.5);
+
+    return bouncePhraseToTable(chord, static_cast<int>(seconds * rate), cyclesToAverage);
+}
+
+void DUMUMUB003AudioProcessor::setMorphSources(const std::array<float, 1024>& from, const std::array<float, 1024>& to)
+{
+    // Sources are copied now, so later edits to the tables do not change the morph
+    backgroundWorker.post("morph", [this, from, to]
+    {
+        morph.build(from, to);
+    });
+}
+
+bool DUMUMUB003AudioProcessor::setMorphPosition(float position)
+{
+    morphPosition = juce::jlimit(0.0f, 1.0f, position);
+
+    std::array<float, 1024> frame;
+    if (!morph.lookup(position, frame))
+        return false;
+
+    copyWaveTableToL(frame);
+    copyWaveTableToR(frame);
+    return true;
+}
+
+bool DUMUMUB003AudioProcessor::bouncePhraseToTable(const juce::MidiBuffer& phrase, int lengthInSamples, int cyclesToAverage)
+{
+    if (phrase.isEmpty() || lengthInSamples <= 0 || bouncing)
+        return false;
+
+    const double rate = getSampleRate() > 0.0 ? getSampleRate() : 44100.0;
+    bouncing = true;
+
+    longJobWorker.post("bounce", [this, phrase, lengthInSamples, cyclesToAverage, rate]
+    {
+        // Render through a private engine so live voices are never touched. The file lock
+        // keeps the granular source in place for each block, so a file drop waits one block at most.
+        OfflineRenderer renderer(*this, expression, zones, multiTimbral);
+        AudioBuffer<float> render(2, lengthInSamples);
+        renderer.render(phrase, render, rate, droppedFilesLock);
+
+        // Analyse the second half, past the attack
+        const int analysisStart = lengthInSamples / 2;
+        const int analysisLength = lengthInSamples - analysisStart;
+        const float* left = render.getReadPointer(0, analysisStart);
+        const float* right = render.getReadPointer(1, analysisStart);
+
+        CycleExtractor extractor;
+        const int window = juce::jmin(analysisLength, CycleExtractor::getRequiredLength(rate));
+        std::vector<float> mono(static_cast<size_t>(window));
+        for (int i = 0; i < window; ++i)
+            mono[static_cast<size_t>(i)] = 0.5f * (left[analysisLength - window + i] + right[analysisLength - window + i]);
+
+        // Chords rarely have a clean common period, so fall back to the lowest note
+        float period = extractor.detectPeriod(mono.data(), window, rate);
+        if (period <= 0.0f)
+        {
+            int lowestNote = 127;
+            for (const auto metadata : phrase)
+                if (metadata.getMessage().isNoteOn())
+                    lowestNote = juce::jmin(lowestNote, metadata.getMessage().getNoteNumber());
+
+            period = static_cast<float>(rate / juce::MidiMessage::getMidiNoteInHertz(lowestNote));
+        }
+
+        std::array<float, 1024> tableL, tableR;
+        if (extractor.extractAveragedCycle(left, right, analysisLength, period, juce::jmax(1, cyclesToAverage), tableL, tableR))
+        {
+            const juce::ScopedLock sl(bounceLock);
+            bounceTableL = tableL;
+            bounceTableR = tableR;
+            bounceReady = true;
+        }
+
+        bouncing = false;
+    });
+
+    return true;
+}
+
+void DUMUMUB003AudioProcessor::setConvolutionEnabled(bool enabled)
+{
+    convolution.setEnabled(enabled);
+    requestConvolutionRebuild();
+}
+
+void DUMUMUB003AudioProcessor::setLimiterEnabled(bool enabled)
+{
+    outputStage.setLimiterEnabled(enabled);
+    setLatencySamples(outputStage.getLatencySamples());
+}
+
+void DUMUMUB003AudioProcessor::requestConvolutionRebuild()
 {
-    // Free up resources when playback stops
+    // Also posted when disabled, so the partitions are freed rather than left resident
+    longJobWorker.post("convolution", [this] { rebuildConvolution(); });
+}
+
+void DUMUMUB003AudioProcessor::rebuildConvolution()
+{
+    // Background thread: partitions are only kept while the stage is enabled
+    const juce::ScopedLock sl(droppedFilesLock);
+
+    if (convolution.isEnabled() && getSampleRate() > 0.0)
+        convolution.loadImpulse(droppedAudio, droppedAudioSampleRate, getSampleRate());
+    else
+        convolution.releaseImpulse();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -178,6 +789,16 @@ bool DUMUMUB003AudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
    #if ! JucePlugin_IsSynth
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
+   #else
+    // The optional sidechain for live capture may be off, mono or stereo
+    if (! layouts.inputBuses.empty())
+    {
+        const auto sidechain = layouts.getChannelSet (true, 0);
+        if (! sidechain.isDisabled()
+         && sidechain != juce::AudioChannelSet::mono()
+         && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
    #endif
 
     return true;
@@ -187,42 +808,90 @@ bool DUMUMUB003AudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 
 void DUMUMUB003AudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    DUMUMUB_REALTIME_AUDIT_SCOPE();
+    DUMUMUB_TIME_PROCESS_BLOCK (processTiming, buffer.getNumSamples());
+    DUMUMUB_TRACE_SCOPE ("audio", "processBlock");
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
+
+    // Pin this block's rate-dependent snapshot, table spectra and zone slots for the voices
+    blockRateData = rateData.acquire();
+    blockSpectra = acquireTableSpectra();
+    zones.acquire(WavetableZoneMap::realtimeReader);
+
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    // Clear unused output channels
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+    // Feed the sidechain to live capture before the shared buffer is cleared for the synth
+    // output (captured cycles are applied by the timer)
+    if (liveCapture.isEnabled() && getBusCount(true) > 0)
+        liveCapture.push(getBusBuffer(buffer, true, 0));
 
-    // Render synthesizer output
-    synthesiser.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // Clear output channels (the input channels may hold sidechain audio)
+    for (auto i = 0; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Calculate RMS loudness levels for both channels
-    float newLoudnessL = 0.0f;
-    float newLoudnessR = 0.0f;
-    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+    // Any note-on counts as activity for idle suspend, and held notes are tracked for
+    // bounce-to-table (checked before the synth consumes the MIDI)
+    bool activity = false;
+    for (const auto metadata : midiMessages)
     {
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        const auto message = metadata.getMessage();
+        if (message.isNoteOn())
         {
-            if (channel == 0)
-            {
-                newLoudnessL += buffer.getSample(channel, sample) * buffer.getSample(channel, sample);
-            }
-            else if (channel == 1)
-            {
-                newLoudnessR += buffer.getSample(channel, sample) * buffer.getSample(channel, sample);
-            }
+            activity = true;
+            heldNotes[static_cast<size_t>(message.getNoteNumber())] = message.getVelocity();
         }
+        else if (message.isNoteOff())
+        {
+            heldNotes[static_cast<size_t>(message.getNoteNumber())] = 0;
+        }
+        else if (message.isAllNotesOff() || message.isAllSoundOff())
+        {
+            for (auto& note : heldNotes)
+                note = 0;
+        }
+    }
+
+    // Render synthesizer output (the synthesiser takes its own lock, contended only while
+    // the message thread swaps voices or sounds)
+    const auto renderStart = juce::Time::getHighResolutionTicks();
+    {
+        DUMUMUB_REALTIME_AUDIT_PERMIT_LOCK (synthesiser.getLock());
+        DUMUMUB_TRACE_SCOPE ("audio", "renderVoices");
+        synthesiser.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    }
+
+    // Voices are done with the spectra and zone slots until the next block
+    spectraInUseByAudioThread.store(-1);
+    zones.release(WavetableZoneMap::realtimeReader);
+
+    // Voice usage and per-voice cost for polyphony sizing
+    voiceStats.update(synthesiser, juce::Time::getHighResolutionTicks() - renderStart, buffer.getNumSamples());
+
+    // Sounding voices also count, so long releases are never cut short by a suspend
+    for (int i = 0; i < synthesiser.getNumVoices() && !activity; ++i)
+        activity = synthesiser.getVoice(i)->isVoiceActive();
+
+    if (activity)
+    {
+        idleSamples = 0;
+        activitySeen = true;
     }
-    newLoudnessL = std::sqrt(newLoudnessL / buffer.getNumSamples());
-    newLoudnessR = std::sqrt(newLoudnessR / buffer.getNumSamples());
-    loudnessL = newLoudnessL;
-    loudnessR = newLoudnessR;
+    else
+    {
+        idleSamples += buffer.getNumSamples();
+    }
+
+    // Post-synth stages (each returns immediately when disabled)
+    convolution.process(buffer);
+    effects.process(buffer);
+    outputStage.process(buffer);
+
+    // Publish output RMS and peak for the level meters
+    outputMeter.process(buffer);
+    loudnessMeter.process(buffer);
 
-    // Update current wavetable display from audio buffer
-    currentWaveBufferTableL = bufferToWaveTableL(buffer);
-    currentWaveBufferTableR = bufferToWaveTableR(buffer);
+    // Hand the raw output to the oscilloscope (no-op while no editor is open)
+    scope.push(buffer);
 }
 
 //==============================================================================
@@ -239,6 +908,8 @@ juce::AudioProcessorEditor* DUMUMUB003AudioProcessor::createEditor()
 //==============================================================================
 void DUMUMUB003AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
+    DUMUMUB_TRACE_SCOPE ("state", "getStateInformation");
+
     // Create XML structure for complete state persistence
     std::unique_ptr<juce::XmlElement> xml (new juce::XmlElement ("DUMUMUB003State"));
 
@@ -253,9 +924,9 @@ void DUMUMUB003AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     }
 
     // GUI state - button selections
-    for (const auto& wave : selectedWaves)
+    for (int i = 0; i < numWaveforms; ++i)
     {
-        xml->setAttribute ("selectedWave_" + wave.first, wave.second);
+        xml->setAttribute ("selectedWave_" + String (getWaveformName (static_cast<Waveform> (i))), isWaveSelected (static_cast<Waveform> (i)));
     }
 
     // Save file paths (GUI state)
@@ -272,12 +943,80 @@ void DUMUMUB003AudioProcessor::getStateInformation (juce::MemoryBlock& destData)
     xml->setAttribute ("leftChannelOn", leftChannelOn);
     xml->setAttribute ("rightChannelOn", rightChannelOn);
 
+    // Save multi-timbral parts that hold a stored patch
+    xml->setAttribute ("multiTimbral", multiTimbral.load());
+    for (int i = 1; i < numParts; ++i)
+    {
+        const auto& part = parts[i];
+        if (!part.used)
+            continue;
+
+        auto* partXml = xml->createNewChildElement ("Part");
+        partXml->setAttribute ("index", i);
+        partXml->setAttribute ("gain", part.gain);
+        partXml->setAttribute ("attack", part.adsrParams.attack);
+        partXml->setAttribute ("decay", part.adsrParams.decay);
+        partXml->setAttribute ("sustain", part.adsrParams.sustain);
+        partXml->setAttribute ("release", part.adsrParams.release);
+        partXml->setAttribute ("waveTableL", juce::MemoryBlock (part.waveTableL.data(), sizeof (part.waveTableL)).toBase64Encoding());
+        partXml->setAttribute ("waveTableR", juce::MemoryBlock (part.waveTableR.data(), sizeof (part.waveTableR)).toBase64Encoding());
+    }
+
+    // Save pitch bend and MPE configuration
+    xml->setAttribute ("mpeEnabled", expression.mpeEnabled.load());
+    xml->setAttribute ("mpeMasterChannel", expression.mpeMasterChannel.load());
+    xml->setAttribute ("pitchBendRange", expression.pitchBendRange.load());
+    xml->setAttribute ("mpeNoteBendRange", expression.mpeNoteBendRange.load());
+
+    // Save oscillator mode, operator, layer, granular and additive controls
+    xml->setAttribute ("oscillatorMode", oscillatorMode.load());
+    xml->setAttribute ("analyticOscillators", analyticEnabled.load());
+    xml->setAttribute ("grainPosition", grainPosition.load());
+    xml->setAttribute ("grainSize", grainSize.load());
+    xml->setAttribute ("grainDensity", grainDensity.load());
+    xml->setAttribute ("grainSpray", grainSpray.load());
+    xml->setAttribute ("grainPitch", grainPitch.load());
+    xml->setAttribute ("operatorMode", operatorMode.load());
+    xml->setAttribute ("operatorRatio", operatorRatio.load());
+    xml->setAttribute ("operatorIndex", operatorIndex.load());
+    xml->setAttribute ("subLevel", subLevel.load());
+    xml->setAttribute ("subOctaves", subOctaves.load());
+    xml->setAttribute ("noiseLevel", noiseLevel.load());
+    xml->setAttribute ("noiseColour", noiseColour.load());
+    xml->setAttribute ("additiveTilt", additiveTilt.load());
+    xml->setAttribute ("additiveOddEven", additiveOddEven.load());
+    xml->setAttribute ("additiveStretch", additiveStretch.load());
+
+    // Save convolution settings
+    xml->setAttribute ("convolutionEnabled", convolution.isEnabled());
+    xml->setAttribute ("convolutionMix", convolution.getMix());
+
+    // Save effects bus
+    effects.writeState (*xml);
+
+    // Save key/velocity zones
+    zones.writeState (*xml);
+
+    // Save output protection
+    xml->setAttribute ("limiterEnabled", outputStage.isLimiterEnabled());
+    xml->setAttribute ("limiterCeiling", outputStage.getCeiling());
+    xml->setAttribute ("limiterRelease", outputStage.getRelease());
+    xml->setAttribute ("softClipperEnabled", outputStage.isClipperEnabled());
+
+    // Save live capture state
+    xml->setAttribute ("liveCaptureEnabled", liveCapture.isEnabled());
+
+    // Save idle suspend time
+    xml->setAttribute ("idleSuspendSeconds", idleSuspendSeconds.load());
+
     // Convert the XML to a string and copy it to the memory block
     copyXmlToBinary (*xml, destData);
 }
 
 void DUMUMUB003AudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
+    DUMUMUB_TRACE_SCOPE ("state", "setStateInformation");
+
     // Convert the memory block to an XML element
     std::unique_ptr<juce::XmlElement> xml (getXmlFromBinary (data, sizeInBytes));
 
@@ -293,12 +1032,8 @@ void DUMUMUB003AudioProcessor::setStateInformation (const void* data, int sizeIn
             waveTableR[i] = xml->getDoubleAttribute ("waveTableR_" + juce::String (i), 0.0);
         }
         // Restore selected waveforms (GUI state)
-        selectedWaves["sine"] = xml->getBoolAttribute ("selectedWave_sine", false);
-        selectedWaves["square"] = xml->getBoolAttribute ("selectedWave_square", false);
-        selectedWaves["triangle"] = xml->getBoolAttribute ("selectedWave_triangle", false);
-        selectedWaves["saw"] = xml->getBoolAttribute ("selectedWave_saw", false);
-        selectedWaves["audio"] = xml->getBoolAttribute ("selectedWave_audio", false);
-        selectedWaves["image"] = xml->getBoolAttribute ("selectedWave_image", false);
+        for (int i = 0; i < numWaveforms; ++i)
+            selectedWaves[static_cast<size_t>(i)] = xml->getBoolAttribute ("selectedWave_" + String (getWaveformName (static_cast<Waveform> (i))), false);
 
         // Restore file paths (GUI state)
         audioPath = xml->getStringAttribute ("audioPath", "");
@@ -314,6 +1049,81 @@ void DUMUMUB003AudioProcessor::setStateInformation (const void* data, int sizeIn
         leftChannelOn = xml->getBoolAttribute ("leftChannelOn", true);
         rightChannelOn = xml->getBoolAttribute ("rightChannelOn", true);
 
+        // Restore multi-timbral parts
+        multiTimbral = xml->getBoolAttribute ("multiTimbral", false);
+        for (auto& part : parts)
+            part.used = false;
+
+        for (auto* partXml : xml->getChildWithTagNameIterator ("Part"))
+        {
+            const int index = partXml->getIntAttribute ("index", 0);
+            if (index < 1 || index >= numParts)
+                continue;
+
+            auto& part = parts[index];
+            part.gain = partXml->getDoubleAttribute ("gain", 1.0);
+            part.adsrParams.attack = partXml->getDoubleAttribute ("attack", 0.1f);
+            part.adsrParams.decay = partXml->getDoubleAttribute ("decay", 0.1f);
+            part.adsrParams.sustain = partXml->getDoubleAttribute ("sustain", 1.0f);
+            part.adsrParams.release = partXml->getDoubleAttribute ("release", 0.1f);
+
+            juce::MemoryBlock tableData;
+            if (tableData.fromBase64Encoding (partXml->getStringAttribute ("waveTableL")) && tableData.getSize() == sizeof (part.waveTableL))
+                std::memcpy (part.waveTableL.data(), tableData.getData(), sizeof (part.waveTableL));
+            if (tableData.fromBase64Encoding (partXml->getStringAttribute ("waveTableR")) && tableData.getSize() == sizeof (part.waveTableR))
+                std::memcpy (part.waveTableR.data(), tableData.getData(), sizeof (part.waveTableR));
+
+            part.used = true;
+        }
+
+        // Restore pitch bend and MPE configuration
+        setMPEEnabled (xml->getBoolAttribute ("mpeEnabled", false));
+        setMPEZone (xml->getIntAttribute ("mpeMasterChannel", 1) != 16);
+        setPitchBendRange (xml->getDoubleAttribute ("pitchBendRange", 2.0));
+        setMPENoteBendRange (xml->getDoubleAttribute ("mpeNoteBendRange", 48.0));
+
+        // Restore oscillator mode, operator, layer, granular and additive controls
+        setOscillatorMode (static_cast<OscillatorMode> (xml->getIntAttribute ("oscillatorMode", 0)));
+        setAnalyticOscillatorsEnabled (xml->getBoolAttribute ("analyticOscillators", true));
+        setGrainPosition (xml->getDoubleAttribute ("grainPosition", 0.5));
+        setGrainSize (xml->getDoubleAttribute ("grainSize", 80.0));
+        setGrainDensity (xml->getDoubleAttribute ("grainDensity", 20.0));
+        setGrainSpray (xml->getDoubleAttribute ("grainSpray", 0.1));
+        setGrainPitch (xml->getDoubleAttribute ("grainPitch", 0.0));
+        setOperatorMode (static_cast<OperatorMode> (xml->getIntAttribute ("operatorMode", 0)));
+        setOperatorRatio (xml->getDoubleAttribute ("operatorRatio", 1.0));
+        setOperatorIndex (xml->getDoubleAttribute ("operatorIndex", 1.0));
+        setSubLevel (xml->getDoubleAttribute ("subLevel", 0.0));
+        setSubOctaves (xml->getIntAttribute ("subOctaves", 1));
+        setNoiseLevel (xml->getDoubleAttribute ("noiseLevel", 0.0));
+        setNoiseColour (static_cast<NoiseGenerator::Colour> (xml->getIntAttribute ("noiseColour", 0)));
+        setAdditiveTilt (xml->getDoubleAttribute ("additiveTilt", 0.0));
+        setAdditiveOddEven (xml->getDoubleAttribute ("additiveOddEven", 0.0));
+        setAdditiveStretch (xml->getDoubleAttribute ("additiveStretch", 0.0));
+
+        // Restore convolution settings (the impulse is rebuilt once the audio file reloads)
+        setConvolutionMix (xml->getDoubleAttribute ("convolutionMix", 0.35));
+        setConvolutionEnabled (xml->getBoolAttribute ("convolutionEnabled", false));
+
+        // Restore effects bus
+        effects.readState (*xml);
+
+        // Restore key/velocity zones
+        zones.readState (*xml);
+        tablesChanged();
+
+        // Restore output protection
+        setLimiterCeiling (xml->getDoubleAttribute ("limiterCeiling", -0.3));
+        setLimiterRelease (xml->getDoubleAttribute ("limiterRelease", 80.0));
+        setSoftClipperEnabled (xml->getBoolAttribute ("softClipperEnabled", false));
+        setLimiterEnabled (xml->getBoolAttribute ("limiterEnabled", false));
+
+        // Restore live capture state
+        setLiveCaptureEnabled (xml->getBoolAttribute ("liveCaptureEnabled", false));
+
+        // Restore idle suspend time
+        setIdleSuspendSeconds (xml->getDoubleAttribute ("idleSuspendSeconds", 0.0));
+
         // Apply the loaded state
         copyWaveTableToL(waveTableL);
         copyWaveTableToR(waveTableR);
@@ -321,16 +1131,12 @@ void DUMUMUB003AudioProcessor::setStateInformation (const void* data, int sizeIn
         // Apply the loaded gain value
         setGain(gain);
 
-        // Reload audio and image files if paths exist
-        if (!audioPath.isEmpty())
-        {
-            setAudioFromPath();
-        }
-        
-        if (!imagePath.isEmpty())
-        {
-            setImageFromPath();
-        }
+        // Reload audio and image files in the background; hosts may restore state from
+        // the audio thread, which must never wait on file I/O
+        requestFileReload();
+
+        // Show the restored settings to the host
+        hostParameters.pullFromEngine();
     }
 }
 
@@ -339,10 +1145,12 @@ void DUMUMUB003AudioProcessor::setStateInformation (const void* data, int sizeIn
 void DUMUMUB003AudioProcessor::setWaveTableL(int index, float value)
 {
     waveTableL[index] = value;
+    tablesChanged();
 }
 void DUMUMUB003AudioProcessor::setWaveTableR(int index, float value)
 {
     waveTableR[index] = value;
+    tablesChanged();
 }
 
 std::array<float, 1024> DUMUMUB003AudioProcessor::getWaveTableL()
@@ -475,28 +1283,33 @@ void DUMUMUB003AudioProcessor::fillImageWavetable()
 // Wavetable manipulation methods
 void DUMUMUB003AudioProcessor::copyWaveTableToL(std::array<float, 1024> source)
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "commitTableL");
     for (int i = 0; i < waveTableL.size(); i++)
     {
         waveTableL[i] = source[i];
     }
+    tablesChanged();
 }
 
 void DUMUMUB003AudioProcessor::copyWaveTableToR(std::array<float, 1024> source)
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "commitTableR");
     for (int i = 0; i < waveTableR.size(); i++)
     {
         waveTableR[i] = source[i];
     }
+    tablesChanged();
 }
 
 // Waveform mixing methods - add selected waveforms to existing content
 void DUMUMUB003AudioProcessor::addWaveTableToL()
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "addTableL");
     std::array<float, 1024> waveTable; for (int i = 0; i < waveTableL.size(); i++) { waveTable[i] = 0;}
     int waveCount = 0;
    
     // Accumulate selected waveforms
-    if (selectedWaves["sine"])
+    if (isWaveSelected(Waveform::sine))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -504,7 +1317,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["square"])
+    if (isWaveSelected(Waveform::square))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -512,7 +1325,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["triangle"])
+    if (isWaveSelected(Waveform::triangle))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -520,7 +1333,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["saw"])
+    if (isWaveSelected(Waveform::saw))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -528,7 +1341,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["audio"])
+    if (isWaveSelected(Waveform::audio))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -536,7 +1349,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["image"])
+    if (isWaveSelected(Waveform::image))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -551,21 +1364,25 @@ void DUMUMUB003AudioProcessor::addWaveTableToL()
     }
     else
     {
-        // Blend new waveforms with existing content (50/50 mix)
-        for (int i = 0; i < waveTableL.size(); i++)
+        // Blend new waveforms with existing content: a spectral 50/50 morph, so
+        // partials in opposite phase glide together instead of cancelling
+        for (int i = 0; i < waveTable.size(); i++)
         {
-            waveTableL[i] = (waveTableL[i] + (waveTable[i] / waveCount)) / 2;
+            waveTable[i] /= waveCount;
         }
+        morph.blend(waveTableL, waveTable, 0.5f, waveTableL);
+        tablesChanged();
     }
 }
 
 void DUMUMUB003AudioProcessor::addWaveTableToR()
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "addTableR");
     std::array<float, 1024> waveTable; for (int i = 0; i < waveTableR.size(); i++) { waveTable[i] = 0;}
     int waveCount = 0;
    
     // Accumulate selected waveforms
-    if (selectedWaves["sine"])
+    if (isWaveSelected(Waveform::sine))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -573,7 +1390,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["square"])
+    if (isWaveSelected(Waveform::square))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -581,7 +1398,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["triangle"])
+    if (isWaveSelected(Waveform::triangle))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -589,7 +1406,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["saw"])
+    if (isWaveSelected(Waveform::saw))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -597,7 +1414,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["audio"])
+    if (isWaveSelected(Waveform::audio))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -605,7 +1422,7 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["image"])
+    if (isWaveSelected(Waveform::image))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -620,22 +1437,26 @@ void DUMUMUB003AudioProcessor::addWaveTableToR()
     }
     else
     {
-        // Blend new waveforms with existing content (50/50 mix)
-        for (int i = 0; i < waveTableR.size(); i++)
+        // Blend new waveforms with existing content: a spectral 50/50 morph, so
+        // partials in opposite phase glide together instead of cancelling
+        for (int i = 0; i < waveTable.size(); i++)
         {
-            waveTableR[i] = (waveTableR[i] + (waveTable[i] / waveCount)) / 2;
+            waveTable[i] /= waveCount;
         }
+        morph.blend(waveTableR, waveTable, 0.5f, waveTableR);
+        tablesChanged();
     }
 }
 
 // Waveform replacement methods - replace existing content with selected waveforms
 void DUMUMUB003AudioProcessor::replaceTableToL()
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "replaceTableL");
     std::array<float, 1024> waveTable; for (int i = 0; i < waveTableL.size(); i++) { waveTable[i] = 0;}
     int waveCount = 0;
    
     // Accumulate selected waveforms
-    if (selectedWaves["sine"])
+    if (isWaveSelected(Waveform::sine))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -643,7 +1464,7 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["square"])
+    if (isWaveSelected(Waveform::square))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -651,7 +1472,7 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["triangle"])
+    if (isWaveSelected(Waveform::triangle))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -659,7 +1480,7 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["saw"])
+    if (isWaveSelected(Waveform::saw))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -667,7 +1488,7 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["audio"])
+    if (isWaveSelected(Waveform::audio))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -675,7 +1496,7 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         }
         waveCount++;
     }
-    if (selectedWaves["image"])
+    if (isWaveSelected(Waveform::image))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -695,16 +1516,18 @@ void DUMUMUB003AudioProcessor::replaceTableToL()
         {
             waveTableL[i] = waveTable[i] / waveCount;
         }
+        tablesChanged();
     }
 }
 
 void DUMUMUB003AudioProcessor::replaceTableToR()
 {
+    DUMUMUB_TRACE_SCOPE ("tables", "replaceTableR");
     std::array<float, 1024> waveTable; for (int i = 0; i < waveTableR.size(); i++) { waveTable[i] = 0;}
     int waveCount = 0;
    
     // Accumulate selected waveforms
-    if (selectedWaves["sine"])
+    if (isWaveSelected(Waveform::sine))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -712,7 +1535,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["square"])
+    if (isWaveSelected(Waveform::square))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -720,7 +1543,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["triangle"])
+    if (isWaveSelected(Waveform::triangle))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -728,7 +1551,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["saw"])
+    if (isWaveSelected(Waveform::saw))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -736,7 +1559,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["audio"])
+    if (isWaveSelected(Waveform::audio))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -744,7 +1567,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         }
         waveCount++;
     }
-    if (selectedWaves["image"])
+    if (isWaveSelected(Waveform::image))
     {
         for (int i = 0; i < waveTable.size(); i++)
         {
@@ -764,6 +1587,7 @@ void DUMUMUB003AudioProcessor::replaceTableToR()
         {
             waveTableR[i] = waveTable[i] / waveCount;
         }
+        tablesChanged();
     }
 }
 
@@ -773,46 +1597,99 @@ void DUMUMUB003AudioProcessor::setGain(float newGain)
     gain = newGain;
 }
 
-void DUMUMUB003AudioProcessor::setWaveformType(String waveform, bool value)
+GranularParameters DUMUMUB003AudioProcessor::getGranularParameters() const
+{
+    GranularParameters params;
+    params.position = grainPosition;
+    params.size = grainSize;
+    params.density = grainDensity;
+    params.spray = grainSpray;
+    params.pitch = grainPitch;
+    return params;
+}
+
+const char* DUMUMUB003AudioProcessor::getWaveformName(Waveform waveform)
+{
+    static const char* const names[numWaveforms] = { "sine", "square", "triangle", "saw", "audio", "image" };
+    return names[static_cast<int>(waveform)];
+}
+
+int DUMUMUB003AudioProcessor::findWaveform(const String& name)
+{
+    for (int i = 0; i < numWaveforms; ++i)
+        if (name == getWaveformName(static_cast<Waveform>(i)))
+            return i;
+    return -1;
+}
+
+void DUMUMUB003AudioProcessor::setWaveformType(const String& waveform, bool value)
 {
-    selectedWaves[waveform] = value;
+    const int index = findWaveform(waveform);
+    jassert (index >= 0);
+    if (index >= 0)
+        selectedWaves[static_cast<size_t>(index)] = value;
+}
+
+bool DUMUMUB003AudioProcessor::getWaveformState(const String& waveform) const
+{
+    const int index = findWaveform(waveform);
+    return index >= 0 && selectedWaves[static_cast<size_t>(index)].load();
 }
 
 // File loading and processing methods
 void DUMUMUB003AudioProcessor::setAudioFromPath()
 {
-    File audioFile(audioPath);
+    DUMUMUB_TRACE_SCOPE ("files", "importAudio");
+    const juce::ScopedLock sl(droppedFilesLock);
+
+    if (loadDroppedAudio(audioPath))
+    {
+        fillAudioWavetableFromAudio(audioWaveL, audioWaveR);
+        suspended = false;
+        requestConvolutionRebuild();
+    }
+}
+
+bool DUMUMUB003AudioProcessor::loadDroppedAudio(const String& path)
+{
+    File audioFile(path);
     AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
     std::unique_ptr<AudioFormatReader> audioReader(formatManager.createReaderFor(audioFile));
-    if (audioReader.get() != nullptr)
+    if (audioReader.get() == nullptr)
+        return false;
+
+    int numChannels = audioReader->numChannels;
+    int numSamples = audioReader->lengthInSamples;
+    AudioBuffer<float> audioBuffer(numChannels, numSamples);
+    audioReader->read(&audioBuffer, 0, numSamples, 0, true, true);
+
+    // Swap in the new buffer while granular voices are locked out, and free the old one outside the lock
     {
-        int numChannels = audioReader->numChannels;
-        int numSamples = audioReader->lengthInSamples;
-        AudioBuffer<float> audioBuffer(numChannels, numSamples);
-        audioReader->read(&audioBuffer, 0, numSamples, 0, true, true);
-        
-        droppedAudio = audioBuffer;
-        fillAudioWavetableFromAudio();
-        
+        const juce::SpinLock::ScopedLockType lock(droppedAudioLock);
+        std::swap(droppedAudio, audioBuffer);
+        droppedAudioSampleRate = audioReader->sampleRate;
     }
+    return true;
 }
 
 void DUMUMUB003AudioProcessor::setImageFromPath()
 {
+    DUMUMUB_TRACE_SCOPE ("files", "importImage");
     File imageFile(imagePath);
     Image image = ImageFileFormat::loadFrom(imageFile);
     if (!image.isNull())
     {
+        const juce::ScopedLock sl(droppedFilesLock);
         droppedImage = image;
-        fillImageWavetableFromImage();
+        fillImageWavetableFromImage(imageWave);
     }
 }
 
-void DUMUMUB003AudioProcessor::fillAudioWavetableFromAudio()
+void DUMUMUB003AudioProcessor::fillAudioWavetableFromAudio(std::array<float, 1024>& tableL, std::array<float, 1024>& tableR)
 {
-    const int wavetableLSize = audioWaveL.size();
-    const int wavetableRSize = audioWaveR.size();
+    const int wavetableLSize = tableL.size();
+    const int wavetableRSize = tableR.size();
     const int numSamples = droppedAudio.getNumSamples();
     const int numChannels = droppedAudio.getNumChannels();
     const int numSamplesPerChannel = numSamples / numChannels;
@@ -825,33 +1702,33 @@ void DUMUMUB003AudioProcessor::fillAudioWavetableFromAudio()
     // Clear existing audio wavetables
     for (int i = 0; i < wavetableLSize; ++i)
     {
-        audioWaveL[i] = 0;
+        tableL[i] = 0;
     }
     for (int i = 0; i < wavetableRSize; ++i)
     {
-        audioWaveR[i] = 0;
+        tableR[i] = 0;
     }
 
     // Extract 1024 samples from the middle of the audio file
     int middle = numSamplesPerChannel / 2;
 
-    for (int i = 0; i < audioWaveL.size(); ++i)
+    for (int i = 0; i < tableL.size(); ++i)
     {
-        audioWaveL[i] = droppedAudio.getSample(0, middle + i); 
+        tableL[i] = droppedAudio.getSample(0, middle + i); 
     }
-    for (int i = 0; i < audioWaveR.size(); ++i)
+    for (int i = 0; i < tableR.size(); ++i)
     {
-        audioWaveR[i] = droppedAudio.getSample(1, middle + i);
+        tableR[i] = droppedAudio.getSample(1, middle + i);
     }
 
     // Normalize to prevent clipping
-    normalizeWave(audioWaveL);
-    normalizeWave(audioWaveR);
+    normalizeWave(tableL);
+    normalizeWave(tableR);
 }
 
-void DUMUMUB003AudioProcessor::fillImageWavetableFromImage()
+void DUMUMUB003AudioProcessor::fillImageWavetableFromImage(std::array<float, 1024>& table)
 {
-    const int wavetableSize = imageWave.size();
+    const int wavetableSize = table.size();
     const int imageWidth = droppedImage.getWidth();
     const int imageHeight = droppedImage.getHeight();
     const float indent = static_cast<float>(imageWidth) / static_cast<float>(wavetableSize);
@@ -864,7 +1741,7 @@ void DUMUMUB003AudioProcessor::fillImageWavetableFromImage()
     // Initialize wavetable
     for (int i = 0; i < wavetableSize; ++i)
     {
-        imageWave[i] = 0;
+        table[i] = 0;
     }
 
     /**
@@ -907,15 +1784,15 @@ void DUMUMUB003AudioProcessor::fillImageWavetableFromImage()
         }
         if (i < wavetableSize / 2)
         {
-            imageWave[i] = (static_cast<float>(darkestY) / static_cast<float>(imageHeight)) * 2.0f - 1.0f;
+            table[i] = (static_cast<float>(darkestY) / static_cast<float>(imageHeight)) * 2.0f - 1.0f;
         }
         else
         {
-            imageWave[i] = ((static_cast<float>(darkestY) / static_cast<float>(imageHeight)) * 2.0f - 1.0f) * -1.0f;
+            table[i] = ((static_cast<float>(darkestY) / static_cast<float>(imageHeight)) * 2.0f - 1.0f) * -1.0f;
         }
     }
 
-    normalizeWave(imageWave);
+    normalizeWave(table);
 }
 
 void DUMUMUB003AudioProcessor::normalizeWave(std::array<float, 1024>& waveTable)
@@ -935,62 +1812,108 @@ void DUMUMUB003AudioProcessor::normalizeWave(std::array<float, 1024>& waveTable)
     }
 }
 
-std::array<float, 1024> DUMUMUB003AudioProcessor::bufferToWaveTableL(AudioBuffer<float>& currentBuffer)
+void DUMUMUB003AudioProcessor::setADSRParameters(const juce::ADSR::Parameters& params)
 {
-    std::array<float, 1024> waveTable;
-    int numSamples = currentBuffer.getNumSamples();
-    int numChannels = currentBuffer.getNumChannels();
-    int numSamplesPerChannel = numSamples / numChannels;
-
-    float stretchFactor = static_cast<float>(numSamplesPerChannel) / waveTable.size();
+    adsrParams = params;
+    tablesChanged();
+    updateVoiceEnvelopes(0, params);
+}
 
-    for (int i = 0; i < waveTable.size(); ++i)
+void DUMUMUB003AudioProcessor::updateVoiceEnvelopes(int partIndex, const juce::ADSR::Parameters& params)
+{
+    // The pool is shared, so only voices playing this part take its envelope
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
     {
-        float sampleIndex = i * stretchFactor;
-        int index1 = static_cast<int>(sampleIndex);
-        int index2 = std::min(index1 + 1, numSamplesPerChannel - 1);
-        float frac = sampleIndex - index1;
-
-        waveTable[i] = (1.0f - frac) * currentBuffer.getSample(0, index1) + frac * currentBuffer.getSample(0, index2);
+        auto* voice = dynamic_cast<WavetableVoice*>(synthesiser.getVoice(i));
+        if (voice != nullptr && voice->getPartIndex() == partIndex)
+            voice->setADSRParameters(params);
     }
+}
 
-    return waveTable;
+// Multi-timbral part management
+void DUMUMUB003AudioProcessor::storePatchToPart(int partIndex)
+{
+    if (partIndex < 1 || partIndex >= numParts)
+        return;
+
+    auto& part = parts[partIndex];
+    part.waveTableL = waveTableL;
+    part.waveTableR = waveTableR;
+    part.adsrParams = adsrParams;
+    part.gain = gain;
+    part.used = true;
+    tablesChanged();
 }
 
-std::array<float, 1024> DUMUMUB003AudioProcessor::bufferToWaveTableR(AudioBuffer<float>& currentBuffer)
+void DUMUMUB003AudioProcessor::recallPartToEditor(int partIndex)
 {
- 
+    if (partIndex < 1 || partIndex >= numParts || !parts[partIndex].used)
+        return;
 
-    std::array<float, 1024> waveTable;
-    int numSamples = currentBuffer.getNumSamples();
-    int numChannels = currentBuffer.getNumChannels();
-    int numSamplesPerChannel = numSamples / numChannels;
+    const auto& part = parts[partIndex];
+    copyWaveTableToL(part.waveTableL);
+    copyWaveTableToR(part.waveTableR);
+    setADSRParameters(part.adsrParams);
+    setGain(part.gain);
+}
 
-    float stretchFactor = static_cast<float>(numSamplesPerChannel) / waveTable.size();
+void DUMUMUB003AudioProcessor::setPartGain(int partIndex, float newGain)
+{
+    if (partIndex == 0)
+        setGain(newGain);
+    else if (partIndex > 0 && partIndex < numParts)
+        parts[partIndex].gain = newGain;
+}
 
-    for (int i = 0; i < waveTable.size(); ++i)
+void DUMUMUB003AudioProcessor::setPartADSRParameters(int partIndex, const juce::ADSR::Parameters& params)
+{
+    if (partIndex == 0)
+        setADSRParameters(params);
+    else if (partIndex > 0 && partIndex < numParts)
     {
-        float sampleIndex = i * stretchFactor;
-        int index1 = static_cast<int>(sampleIndex);
-        int index2 = std::min(index1 + 1, numSamplesPerChannel - 1);
-        float frac = sampleIndex - index1;
-
-        waveTable[i] = (1.0f - frac) * currentBuffer.getSample(1, index1) + frac * currentBuffer.getSample(1, index2);
+        parts[partIndex].adsrParams = params;
+        tablesChanged();
+        updateVoiceEnvelopes(partIndex, params);
     }
+}
 
-    return waveTable;
+int DUMUMUB003AudioProcessor::addZoneFromEditor(int set, const WavetableZone& zone)
+{
+    const int zoneIndex = zones.addZone(set, zone, waveTableL, waveTableR);
+    tablesChanged();
+    return zoneIndex;
 }
 
-void DUMUMUB003AudioProcessor::setADSRParameters(const juce::ADSR::Parameters& params)
+void DUMUMUB003AudioProcessor::updateZoneFromEditor(int set, int zoneIndex)
 {
-    adsrParams = params;
+    zones.setZoneTables(set, zoneIndex, waveTableL, waveTableR);
+    tablesChanged();
+}
 
-    // Update all voices' ADSR params
-    for (int i = 0; i < synthesiser.getNumVoices(); ++i)
-    {
-        if (auto* voice = dynamic_cast<WavetableVoice*>(synthesiser.getVoice(i)))
-            voice->setADSRParameters(params);
-    }
+void DUMUMUB003AudioProcessor::clearZoneSet(int set)
+{
+    zones.clearSet(set);
+    tablesChanged();
+}
+
+const std::array<float, 1024>& DUMUMUB003AudioProcessor::getPartWaveTableL(int partIndex) const
+{
+    return (partIndex > 0 && partIndex < numParts) ? parts[partIndex].waveTableL : waveTableL;
+}
+
+const std::array<float, 1024>& DUMUMUB003AudioProcessor::getPartWaveTableR(int partIndex) const
+{
+    return (partIndex > 0 && partIndex < numParts) ? parts[partIndex].waveTableR : waveTableR;
+}
+
+float DUMUMUB003AudioProcessor::getPartGain(int partIndex) const
+{
+    return (partIndex > 0 && partIndex < numParts) ? parts[partIndex].gain : gain;
+}
+
+juce::ADSR::Parameters DUMUMUB003AudioProcessor::getPartADSRParameters(int partIndex) const
+{
+    return (partIndex > 0 && partIndex < numParts) ? parts[partIndex].adsrParams : adsrParams;
 }
 
 //==============================================================================
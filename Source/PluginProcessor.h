@@ -14,6 +14,28 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "GranularOscillator.h"
+#include "WavetableSynthesiser.h"
+#include "BackgroundWorker.h"
+#include "RateDataBuilder.h"
+#include "ConvolutionStage.h"
+#include "EffectsChain.h"
+#include "OutputStage.h"
+#include "LiveInputCapture.h"
+#include "OfflineRenderer.h"
+#include "AnalyticOscillator.h"
+#include "AdditiveOscillator.h"
+#include "SpectralMorph.h"
+#include "NoiseGenerator.h"
+#include "LevelMeter.h"
+#include "ScopeBuffer.h"
+#include "LoudnessMeter.h"
+#include "SpectrumAnalyser.h"
+#include "ProcessTiming.h"
+#include "RealtimeAudit.h"
+#include "TraceRecorder.h"
+#include "VoiceStats.h"
+#include "HostParameters.h"
 
 //==============================================================================
 /**
@@ -22,14 +44,33 @@
  * Features:
  * - Polyphonic wavetable synthesis with ADSR envelopes
  * - Multiple waveform types (sine, square, triangle, sawtooth)
+ * - Band-limited analytic oscillators for unmodified basic shapes
  * - Audio file import and wavetable generation
  * - Image-to-wavetable conversion
  * - Real-time wavetable editing
+ * - Spectral (magnitude/phase) morphing and blending between tables
+ * - Granular playback of dropped audio files
+ * - Inverse-FFT additive resynthesis of the tables with per-partial shaping
+ * - Phase and ring modulation between the left and right tables
+ * - Per-voice sub-oscillator and white/pink/sample-and-hold noise layers
+ * - 16-part multi-timbral operation over a shared voice pool
+ * - Key/velocity wavetable zones in keyswitched slot sets
+ * - Pitch bend and MPE per-note expression
+ * - Idle suspend that frees dropped files while the instance is silent
+ * - Zero-latency convolution using the dropped audio file as the impulse
+ * - Built-in chorus, stereo delay and plate reverb
+ * - Output soft clipper and true-peak lookahead limiter
+ * - Background FFT spectrum view of the output and the current tables
+ * - processBlock load histogram and deadline-miss counting
+ * - EBU R128 loudness (momentary, short-term, integrated, range) and true-peak metering
+ * - Live wavetable capture from a sidechain input
+ * - Bounce-to-table from an offline render of the held chord
  * - Independent stereo channel processing
  * - Comprehensive state persistence
  */
 
-class DUMUMUB003AudioProcessor  : public juce::AudioProcessor
+class DUMUMUB003AudioProcessor  : public juce::AudioProcessor,
+                                  private juce::Timer
 {
 public:
     //==============================================================================
@@ -98,37 +139,198 @@ public:
     void replaceTableToR();
 
     // GUI State Management
-    void setWaveformType(String waveform, bool value);
+    // Basic waveforms selected for add/replace, indexed by Waveform; names are the saved-state keys
+    enum class Waveform { sine = 0, square, triangle, saw, audio, image };
+    static constexpr int numWaveforms = 6;
+    static const char* getWaveformName(Waveform waveform);
+    void setWaveformType(const String& waveform, bool value);
 
     // File Management
+    // The paths belong to the message thread; background jobs are handed copies
     void setAudioPath(String path){ audioPath = path; }
     void setImagePath(String path){ imagePath = path; }
     String getAudioPath(){ return audioPath; }
     String getImagePath(){ return imagePath; }
     void setAudioFromPath();
     void setImageFromPath();
-    void fillAudioWavetableFromAudio();
-    void fillImageWavetableFromImage();
+    bool loadDroppedAudio(const String& path);
+    void fillAudioWavetableFromAudio(std::array<float, 1024>& tableL, std::array<float, 1024>& tableR);
+    void fillImageWavetableFromImage(std::array<float, 1024>& table);
 
     // Utility Functions
     void normalizeWave(std::array<float, 1024>& waveTable);
 
     // Audio Analysis
-    float getLoudnessL(){ return loudnessL; }
-    float getLoudnessR(){ return loudnessR; }
-
-    // Buffer Conversion
-    std::array<float, 1024> bufferToWaveTableL(AudioBuffer<float>& buffer);
-    std::array<float, 1024> bufferToWaveTableR(AudioBuffer<float>& buffer);
-
-    std::array<float, 1024> getCurrentBufferL(){ return currentWaveBufferTableL; }
-    std::array<float, 1024> getCurrentBufferR(){ return currentWaveBufferTableR; }
+    LevelMeter& getOutputMeter() { return outputMeter; }
+    LoudnessMeter& getLoudnessMeter() { return loudnessMeter; }
+
+    // processBlock timing histogram and deadline misses (see ProcessTiming.h)
+    ProcessTiming& getProcessTiming() { return processTiming; }
+
+    // Voice Statistics
+    // Active, peak, stolen and dropped voices, note lifetime and per-voice cost, updated once per block
+    VoiceStats::Snapshot getVoiceStatistics() const { return voiceStats.getSnapshot(); }
+    void resetVoiceStatistics() { voiceStats.requestReset(); }
+
+    // Oscilloscope capture (fed only while the editor is open)
+    ScopeBuffer& getScope() { return scope; }
+
+    // Spectrum view: analysis of the scope ring and the given tables runs on the background
+    // worker; the editor picks up finished points
+    void requestSpectrumAnalysis(const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+    bool getSpectrumView(SpectrumAnalyser::View& view) { return spectrumAnalyser.getView(view); }
+
+    // Host parameters bound to the engine settings below (the editor's engine panel attaches to these)
+    HostParameters& getHostParameters() { return hostParameters; }
+
+    // Oscillator Mode
+    enum class OscillatorMode { wavetable = 0, granular, additive };
+    void setOscillatorMode(OscillatorMode mode) { oscillatorMode = static_cast<int>(mode); }
+    OscillatorMode getOscillatorMode() const { return static_cast<OscillatorMode>(oscillatorMode.load()); }
+
+    // Granular Controls
+    void setGrainPosition(float position) { grainPosition = juce::jlimit(0.0f, 1.0f, position); }
+    void setGrainSize(float milliseconds) { grainSize = juce::jlimit(5.0f, 1000.0f, milliseconds); }
+    void setGrainDensity(float grainsPerSecond) { grainDensity = juce::jlimit(0.5f, 500.0f, grainsPerSecond); }
+    void setGrainSpray(float spray) { grainSpray = juce::jlimit(0.0f, 1.0f, spray); }
+    void setGrainPitch(float semitones) { grainPitch = juce::jlimit(-48.0f, 48.0f, semitones); }
+    GranularParameters getGranularParameters() const;
+
+    // Cross-Modulation Operators (wavetable mode)
+    // Each channel's table is phase- or ring-modulated by the other channel's table running at
+    // ratio x the note. Index is the peak phase deviation in radians, or the ring depth (0-1).
+    enum class OperatorMode { off = 0, phaseModulation, ringModulation };
+    void setOperatorMode(OperatorMode mode) { operatorMode = static_cast<int>(mode); }
+    OperatorMode getOperatorMode() const { return static_cast<OperatorMode>(operatorMode.load()); }
+    void setOperatorRatio(float ratio) { operatorRatio = juce::jlimit(0.125f, 16.0f, ratio); }
+    void setOperatorIndex(float index) { operatorIndex = juce::jlimit(0.0f, 8.0f, index); }
+    float getOperatorRatio() const { return operatorRatio; }
+    float getOperatorIndex() const { return operatorIndex; }
+
+    // Sub-Oscillator and Noise Layers (mixed in under each voice's envelope and gain)
+    // The sub reads the voice's own tables one or two octaves down; sample-and-hold noise
+    // picks a new value once per cycle of the note.
+    void setSubLevel(float newLevel) { subLevel = juce::jlimit(0.0f, 1.0f, newLevel); }
+    void setSubOctaves(int octaves) { subOctaves = juce::jlimit(1, 2, octaves); }
+    void setNoiseLevel(float newLevel) { noiseLevel = juce::jlimit(0.0f, 1.0f, newLevel); }
+    void setNoiseColour(NoiseGenerator::Colour colour) { noiseColour = static_cast<int>(colour); }
+    float getSubLevel() const { return subLevel; }
+    int getSubOctaves() const { return subOctaves; }
+    float getNoiseLevel() const { return noiseLevel; }
+    NoiseGenerator::Colour getNoiseColour() const { return static_cast<NoiseGenerator::Colour>(noiseColour.load()); }
+
+    // Additive Controls (tilt in dB/octave, odd/even balance, inharmonic stretch coefficient)
+    void setAdditiveTilt(float dbPerOctave) { additiveTilt = juce::jlimit(-12.0f, 12.0f, dbPerOctave); }
+    void setAdditiveOddEven(float balance) { additiveOddEven = juce::jlimit(-1.0f, 1.0f, balance); }
+    void setAdditiveStretch(float coefficient) { additiveStretch = juce::jlimit(0.0f, 0.01f, coefficient); }
+    float getAdditiveTilt() const { return additiveTilt; }
+    float getAdditiveOddEven() const { return additiveOddEven; }
+    float getAdditiveStretch() const { return additiveStretch; }
+
+    // Partials of each part's tables, refreshed from the timer after edits (channel 0 = left, 1 = right).
+    // Realtime voices read the bank pinned for the current block; offline voices read the published
+    // bank, which stays put while a bounce runs.
+    const TableSpectrum& getTableSpectrum(int partIndex, int channel, bool offline = false) const;
+
+    // Granular Source Access (audio thread must only try-lock)
+    const juce::SpinLock& getDroppedAudioLock() const { return droppedAudioLock; }
+    const AudioBuffer<float>& getDroppedAudio() const { return droppedAudio; }
+    double getDroppedAudioSampleRate() const { return droppedAudioSampleRate; }
+
+    // Multi-Timbral Parts
+    // Part 0 is the patch shown in the editor; parts 1-15 hold stored snapshots.
+    static constexpr int numParts = 16;
+    static constexpr int numVoices = 32;
+    void setMultiTimbral(bool enabled) { multiTimbral = enabled; if (enabled) expression.mpeEnabled = false; }
+    bool isMultiTimbral() const { return multiTimbral; }
+    void storePatchToPart(int partIndex);
+    void recallPartToEditor(int partIndex);
+    void setPartGain(int partIndex, float newGain);
+    void setPartADSRParameters(int partIndex, const juce::ADSR::Parameters& params);
+    const std::array<float, 1024>& getPartWaveTableL(int partIndex) const;
+    const std::array<float, 1024>& getPartWaveTableR(int partIndex) const;
+    float getPartGain(int partIndex) const;
+    juce::ADSR::Parameters getPartADSRParameters(int partIndex) const;
+
+    // Key/Velocity Zones
+    // Zones override part 0's tables; each new zone captures the editor tables as its slot.
+    int addZoneFromEditor(int set, const WavetableZone& zone);
+    void updateZoneFromEditor(int set, int zoneIndex);
+    void clearZoneSet(int set);
+    WavetableZoneMap& getZones() { return zones; }
+
+    // Pitch Bend and MPE
+    // MPE and multi-timbral mode both claim MIDI channels, so enabling one disables the other.
+    void setMPEEnabled(bool enabled) { expression.mpeEnabled = enabled; if (enabled) multiTimbral = false; }
+    bool isMPEEnabled() const { return expression.mpeEnabled; }
+    void setMPEZone(bool lowerZone) { expression.mpeMasterChannel = lowerZone ? 1 : 16; }
+    void setPitchBendRange(float semitones) { expression.pitchBendRange = juce::jlimit(0.0f, 96.0f, semitones); }
+    void setMPENoteBendRange(float semitones) { expression.mpeNoteBendRange = juce::jlimit(0.0f, 96.0f, semitones); }
+    const ExpressionSettings& getExpressionSettings() const { return expression; }
+
+    // Idle Suspend
+    // After this many seconds without notes the dropped files are freed (0 disables).
+    // They are reloaded in the background on the next note or prepareToPlay.
+    void setIdleSuspendSeconds(float seconds) { idleSuspendSeconds = juce::jlimit(0.0f, 3600.0f, seconds); }
+    float getIdleSuspendSeconds() const { return idleSuspendSeconds; }
+    bool isSuspended() const { return suspended; }
+
+    // Convolution (the dropped audio file is the impulse response)
+    void setConvolutionEnabled(bool enabled);
+    bool isConvolutionEnabled() const { return convolution.isEnabled(); }
+    void setConvolutionMix(float mix) { convolution.setMix(mix); }
+    float getConvolutionMix() const { return convolution.getMix(); }
+
+    // Effects Bus (chorus -> delay -> reverb; parameters are set on the individual effects)
+    EffectsChain& getEffects() { return effects; }
+
+    // Output Protection (limiter changes the reported latency)
+    void setLimiterEnabled(bool enabled);
+    bool isLimiterEnabled() const { return outputStage.isLimiterEnabled(); }
+    void setLimiterCeiling(float decibels) { outputStage.setCeiling(decibels); }
+    float getLimiterCeiling() const { return outputStage.getCeiling(); }
+    void setLimiterRelease(float milliseconds) { outputStage.setRelease(milliseconds); }
+    float getLimiterRelease() const { return outputStage.getRelease(); }
+    void setSoftClipperEnabled(bool enabled) { outputStage.setClipperEnabled(enabled); }
+    bool isSoftClipperEnabled() const { return outputStage.isClipperEnabled(); }
+
+    // Live Capture (sidechain cycles continuously replace the editor tables while enabled)
+    void setLiveCaptureEnabled(bool enabled) { liveCapture.setEnabled(enabled); }
+    bool isLiveCaptureEnabled() const { return liveCapture.isEnabled(); }
+
+    // Spectral Morph
+    // Frames between the two sources are built on the background thread; moving the morph
+    // position then writes a precomputed frame into both editor tables without an FFT.
+    void setMorphSources(const std::array<float, 1024>& from, const std::array<float, 1024>& to);
+    void morphBetweenChannels() { setMorphSources(waveTableL, waveTableR); }
+    bool setMorphPosition(float position);
+    float getMorphPosition() const { return morphPosition; }
+
+    // Bounce to Table
+    // Renders the held chord (or a given phrase) offline on the background thread, then
+    // averages cycles from the sustain into the editor tables. Returns false if nothing to render.
+    bool bounceToTable(int cyclesToAverage = 8);
+    bool bouncePhraseToTable(const juce::MidiBuffer& phrase, int lengthInSamples, int cyclesToAverage = 8);
+    bool isBouncing() const { return bouncing; }
+
+    // Sample-Rate-Dependent Data (snapshot pinned for the current block, audio thread only)
+    const RateDependentData* getRateData() const { return blockRateData; }
+
+    // Bumped on every table or envelope edit so held voices drop their period caches
+    juce::uint32 getTableVersion() const { return tableVersion.load(std::memory_order_relaxed); }
+
+    // Analytic Oscillators
+    // Tables holding an unmodified basic shape play analytically. Any edit falls back to the
+    // table until the timer has reclassified it (channel 0 = left, 1 = right).
+    void setAnalyticOscillatorsEnabled(bool enabled) { analyticEnabled = enabled; }
+    bool areAnalyticOscillatorsEnabled() const { return analyticEnabled; }
+    AnalyticOscillator::Shape getAnalyticShape(int partIndex, int channel) const;
 
     // ADSR Control
     void setADSRParameters(const juce::ADSR::Parameters& params);
 
     // GUI state access methods
-    bool getWaveformState(const String& waveform) { return selectedWaves[waveform]; }
+    bool getWaveformState(const String& waveform) const;
     juce::ADSR::Parameters getADSRParameters() { return adsrParams; }
     
     // Channel State Management
@@ -160,24 +362,142 @@ private:
     String audioPath;
     String imagePath;
     AudioBuffer<float> droppedAudio;
+    double droppedAudioSampleRate = 44100.0;
+    juce::SpinLock droppedAudioLock;
     Image droppedImage;
+    juce::CriticalSection droppedFilesLock;
 
     // Synthesis Engine
-    Synthesiser synthesiser;
+    ExpressionSettings expression;
+    WavetableZoneMap zones;
+    WavetableSynthesiser synthesiser { expression, zones };
+    std::atomic<int> oscillatorMode { static_cast<int>(OscillatorMode::wavetable) };
+
+    // Post-Synth Stages
+    ConvolutionStage convolution;
+    EffectsChain effects;
+    OutputStage outputStage;
+    LiveInputCapture liveCapture;
+
+    // Convolution State (impulse rebuilt from the dropped audio on the background worker)
+    void requestConvolutionRebuild();
+    void rebuildConvolution();
+
+    // Spectral Morph (built frames, plus the one-off blend used by the add buttons)
+    SpectralMorph morph;
+    std::atomic<float> morphPosition { 0.0f };
+
+    // Bounce to Table State
+    std::array<std::atomic<juce::uint8>, 128> heldNotes;
+    juce::CriticalSection bounceLock;
+    std::array<float, 1024> bounceTableL;
+    std::array<float, 1024> bounceTableR;
+    std::atomic<bool> bounceReady { false };
+    std::atomic<bool> bouncing { false };
+
+    // File Reload State (decoded on the worker after a state restore; the derived tables are
+    // applied from the timer, since the add and replace buttons read them unlocked)
+    void requestFileReload();
+    juce::CriticalSection reloadLock;
+    std::array<float, 1024> reloadedAudioL;
+    std::array<float, 1024> reloadedAudioR;
+    std::array<float, 1024> reloadedImage;
+    std::atomic<bool> reloadedAudioReady { false };
+    std::atomic<bool> reloadedImageReady { false };
+
+    // Multi-Timbral Parts (index 0 unused - part 0 lives in the editor tables)
+    struct SynthPart
+    {
+        std::array<float, 1024> waveTableL;
+        std::array<float, 1024> waveTableR;
+        juce::ADSR::Parameters adsrParams;
+        float gain = 1.0f;
+        bool used = false;
+    };
+    std::array<SynthPart, numParts> parts;
+    std::atomic<bool> multiTimbral { false };
+    void updateVoiceEnvelopes(int partIndex, const juce::ADSR::Parameters& params);
+
+    // Edit counter for voice period caches (relaxed: a voice only compares it once per tick)
+    std::atomic<juce::uint32> tableVersion { 0 };
+    void tablesChanged() { tableVersion.fetch_add(1, std::memory_order_relaxed); }
+
+    // Basic-shape classification per part and channel, valid while classifiedVersion matches
+    void classifyAnalyticShapes();
+    std::array<std::atomic<int>, numParts * 2> analyticShapes;
+    std::atomic<juce::uint32> classifiedVersion { 0xffffffffu };
+    std::atomic<bool> analyticEnabled { true };
+
+    // Granular Parameters
+    std::atomic<float> grainPosition { 0.5f };
+    std::atomic<float> grainSize { 80.0f };
+    std::atomic<float> grainDensity { 20.0f };
+    std::atomic<float> grainSpray { 0.1f };
+    std::atomic<float> grainPitch { 0.0f };
+
+    // Operator Parameters
+    std::atomic<int> operatorMode { static_cast<int>(OperatorMode::off) };
+    std::atomic<float> operatorRatio { 1.0f };
+    std::atomic<float> operatorIndex { 1.0f };
+
+    // Layer Parameters
+    std::atomic<float> subLevel { 0.0f };
+    std::atomic<int> subOctaves { 1 };
+    std::atomic<float> noiseLevel { 0.0f };
+    std::atomic<int> noiseColour { static_cast<int>(NoiseGenerator::Colour::white) };
+
+    // Additive Parameters and Table Spectra
+    // Double-buffered: the timer fills the bank the audio thread has not pinned and then publishes
+    // it, so voices only ever change spectra between blocks, never partway through a run.
+    std::atomic<float> additiveTilt { 0.0f };
+    std::atomic<float> additiveOddEven { 0.0f };
+    std::atomic<float> additiveStretch { 0.0f };
+    bool analyseTableSpectra();
+    int acquireTableSpectra() noexcept;
+    std::array<std::array<TableSpectrum, numParts * 2>, 2> tableSpectra;
+    std::atomic<int> publishedSpectra { 0 };
+    std::atomic<int> spectraInUseByAudioThread { -1 };
+    int blockSpectra = 0;                       // Audio thread only
+    juce::uint32 analysedSpectraVersion = 0;    // Message thread only
+    juce::dsp::FFT spectrumFFT { AdditiveOscillator::fftOrder };
+    std::vector<float> spectrumScratch;
 
     // GUI State
-    std::map<String, bool> selectedWaves;
+    // Fixed and lock-free, so reading the selection never allocates
+    static int findWaveform(const String& name);
+    bool isWaveSelected(Waveform waveform) const { return selectedWaves[static_cast<size_t>(waveform)].load(std::memory_order_relaxed); }
+    std::array<std::atomic<bool>, numWaveforms> selectedWaves {};
 
     // Audio Analysis
-    float loudnessL;
-    float loudnessR;
+    LevelMeter outputMeter;
+    LoudnessMeter loudnessMeter;
+    ProcessTiming processTiming;
+    VoiceStats voiceStats;
 
     // Real-time Buffer Processing
-    std::array<float, 1024> currentWaveBufferTableL;
-    std::array<float, 1024> currentWaveBufferTableR;
-
-    // Initialization State
-    bool waveTablesInitialized = false;
+    ScopeBuffer scope;
+    SpectrumAnalyser spectrumAnalyser;
+
+    // Background Work and Sample-Rate-Dependent Data
+    // Long jobs (bounce renders, impulse resampling) get their own worker, so rate rebuilds,
+    // file reloads and spectrum analysis never queue behind them
+    BackgroundWorker backgroundWorker;
+    BackgroundWorker longJobWorker { "DUMUMUB Long Job Worker" };
+    RateDataBuilder rateData { backgroundWorker };
+    const RateDependentData* blockRateData = nullptr;
+
+    // Host Parameters
+    void createParameters();
+    HostParameters hostParameters { *this };
+
+    // Idle Suspend State
+    void timerCallback() override;
+    void requestSuspend(bool force);
+    void requestResume();
+    std::atomic<float> idleSuspendSeconds { 0.0f };   // Off unless the user opts in
+    std::atomic<juce::int64> idleSamples { 0 };
+    std::atomic<bool> activitySeen { false };
+    std::atomic<bool> suspended { false };
 
     // Envelope Parameters
     juce::ADSR::Parameters adsrParams;
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    ProcessTiming.h
+
+    processBlock timing histogram and deadline-miss counter for
+    DUMUMUB wavetable synthesizer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+// Build with DUMUMUB_PROCESS_TIMING=0 to compile the measurement out entirely
+#ifndef DUMUMUB_PROCESS_TIMING
+ #define DUMUMUB_PROCESS_TIMING 1
+#endif
+
+//==============================================================================
+/**
+ * Process Timing - Block Load Histogram and Deadline Misses
+ *
+ * Each processBlock is timed with the monotonic high-resolution tick counter
+ * and recorded as a fraction of its real-time budget (block length over
+ * sample rate). Loads go into a fixed histogram of 2.5% bins up to 160%,
+ * with the last bin catching everything above; blocks over the deadline
+ * fraction are counted as misses.
+ *
+ * The audio thread is the only writer: counters are relaxed atomics updated
+ * with plain load/store, and a reset from another thread is a request the
+ * audio thread picks up at its next block. Readers get a snapshot.
+ */
+class ProcessTiming
+{
+public:
+    static constexpr int numBins = 64;
+    static constexpr float binWidth = 0.025f;
+
+    struct Stats
+    {
+        juce::uint64 blocks = 0;
+        juce::uint64 misses = 0;
+        float maximumLoad = 0.0f;
+        float deadlineFraction = 0.0f;
+        std::array<juce::uint64, numBins> histogram {};
+    };
+
+    ProcessTiming()
+    {
+        ticksPerSecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+    }
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        requestReset();
+    }
+
+    void setEnabled(bool shouldBeEnabled) { enabled = shouldBeEnabled; }
+    bool isEnabled() const { return enabled; }
+
+    // Load (fraction of the block's budget) above which a block counts as a miss
+    void setDeadlineFraction(float fraction) { deadlineFraction = juce::jlimit(0.1f, 1.0f, fraction); }
+    float getDeadlineFraction() const { return deadlineFraction; }
+
+    void requestReset() { resetRequested = true; }
+
+    // Audio thread: record one block
+    void record(juce::int64 startTicks, juce::int64 endTicks, int numSamples)
+    {
+        if (resetRequested.exchange(false))
+            reset();
+
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        const double budgetSeconds = numSamples / sampleRate;
+        const auto load = static_cast<float>((endTicks - startTicks) / ticksPerSecond / budgetSeconds);
+
+        const int bin = juce::jlimit(0, numBins - 1, static_cast<int>(load / binWidth));
+        increment(histogram[static_cast<size_t>(bin)]);
+        increment(blocks);
+        if (load > deadlineFraction.load(std::memory_order_relaxed))
+            increment(misses);
+        if (load > maximumLoad.load(std::memory_order_relaxed))
+            maximumLoad.store(load, std::memory_order_relaxed);
+    }
+
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.blocks = blocks.load(std::memory_order_relaxed);
+        stats.misses = misses.load(std::memory_order_relaxed);
+        stats.maximumLoad = maximumLoad.load(std::memory_order_relaxed);
+        stats.deadlineFraction = deadlineFraction.load(std::memory_order_relaxed);
+        for (int bin = 0; bin < numBins; ++bin)
+            stats.histogram[static_cast<size_t>(bin)] = histogram[static_cast<size_t>(bin)].load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    // One-line summary for the editor
+    juce::String getSummary() const
+    {
+        const auto stats = getStats();
+        return juce::String(static_cast<juce::int64>(stats.blocks)) + " blocks, "
+             + juce::String(static_cast<juce::int64>(stats.misses)) + " over "
+             + juce::String(juce::roundToInt(stats.deadlineFraction * 100.0f)) + "% of budget, peak load "
+             + juce::String(stats.maximumLoad * 100.0f, 1) + "%";
+    }
+
+    // Full report: summary, then one line per non-empty histogram bin
+    bool writeReport(const juce::File& file) const
+    {
+        const auto stats = getStats();
+        juce::String report;
+        report << "DUMUMUB-003 processBlock timing" << juce::newLine
+               << getSummary() << juce::newLine << juce::newLine
+               << "load (% of budget)\tblocks" << juce::newLine;
+
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const auto count = stats.histogram[static_cast<size_t>(bin)];
+            if (count == 0)
+                continue;
+
+            const juce::String low(bin * binWidth * 100.0f, 1);
+            const juce::String high = bin == numBins - 1 ? juce::String("...") : juce::String((bin + 1) * binWidth * 100.0f, 1);
+            report << low << " - " << high << "\t" << juce::String(static_cast<juce::int64>(count)) << juce::newLine;
+        }
+
+        return file.replaceWithText(report);
+    }
+
+    //==============================================================================
+    // Times the enclosing scope of processBlock
+    class ScopedBlock
+    {
+    public:
+        ScopedBlock(ProcessTiming& owner, int samples)
+            : timing(owner), numSamples(samples),
+              startTicks(owner.isEnabled() ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedBlock()
+        {
+            if (startTicks != 0)
+                timing.record(startTicks, juce::Time::getHighResolutionTicks(), numSamples);
+        }
+
+    private:
+        ProcessTiming& timing;
+        const int numSamples;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedBlock)
+    };
+
+private:
+    // Single writer, so no read-modify-write instruction is needed
+    template <typename Counter>
+    static void increment(std::atomic<Counter>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        for (auto& bin : histogram)
+            bin.store(0, std::memory_order_relaxed);
+        blocks.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+        maximumLoad.store(0.0f, std::memory_order_relaxed);
+    }
+
+    double ticksPerSecond = 1.0;
+    double sampleRate = 0.0;
+
+    std::array<std::atomic<juce::uint64>, numBins> histogram {};
+    std::atomic<juce::uint64> blocks { 0 };
+    std::atomic<juce::uint64> misses { 0 };
+    std::atomic<float> maximumLoad { 0.0f };
+
+    std::atomic<bool> enabled { true };
+    std::atomic<bool> resetRequested { false };
+    std::atomic<float> deadlineFraction { 0.7f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProcessTiming)
+};
+
+// Time the rest of the enclosing scope (expands to nothing when compiled out)
+#if DUMUMUB_PROCESS_TIMING
+ #define DUMUMUB_TIME_PROCESS_BLOCK(timing, numSamples) \
+    const ProcessTiming::ScopedBlock processTimingScope (timing, numSamples)
+#else
+ #define DUMUMUB_TIME_PROCESS_BLOCK(timing, numSamples)
+#endif
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    RateDataBuilder.cpp
+
+    Background build and atomic publication of sample-rate-dependent data.
+
+  ==============================================================================
+*/
+
+#include "RateDataBuilder.h"
+
+//==============================================================================
+RateDataBuilder::RateDataBuilder(BackgroundWorker& worker) : backgroundWorker(worker)
+{
+}
+
+RateDataBuilder::~RateDataBuilder()
+{
+    // The owner stops the worker first, so nothing can be mid-build here
+    delete current.exchange(nullptr);
+}
+
+void RateDataBuilder::buildNow(double sampleRate, int maximumBlockSize)
+{
+    publish(build(sampleRate, maximumBlockSize));
+}
+
+void RateDataBuilder::requestRebuild(double sampleRate, int maximumBlockSize)
+{
+    // Skip the rebuild entirely if nothing rate-dependent has changed
+    if (auto* data = current.load())
+        if (data->sampleRate == sampleRate && data->maximumBlockSize >= maximumBlockSize)
+            return;
+
+    backgroundWorker.post("rateData", [this, sampleRate, maximumBlockSize]
+    {
+        publish(build(sampleRate, maximumBlockSize));
+    });
+}
+
+const RateDependentData* RateDataBuilder::acquire() noexcept
+{
+    // Announce the snapshot we are about to use, then confirm it is still current.
+    // If a publish slipped in between, retry so the builder never frees what we hold.
+    for (;;)
+    {
+        auto* data = current.load();
+        inUseByAudioThread.store(data);
+
+        if (current.load() == data)
+            return data;
+    }
+}
+
+std::unique_ptr<RateDependentData> RateDataBuilder::build(double sampleRate, int maximumBlockSize)
+{
+    auto data = std::make_unique<RateDependentData>();
+    data->sampleRate = sampleRate;
+    data->maximumBlockSize = maximumBlockSize;
+
+    // Tuning table for the 1024-sample wavetables
+    data->incrementPerHz = static_cast<float>(1024.0 / sampleRate);
+    for (int note = 0; note < 128; ++note)
+        data->noteIncrements[note] = static_cast<float>(juce::MidiMessage::getMidiNoteInHertz(note) * data->incrementPerHz);
+
+    // Parameter smoothing at the voice control rate
+    const double smoothingTime = 0.02;
+    data->parameterSmoothing = static_cast<float>(1.0 - std::exp(-RateDependentData::controlInterval / (smoothingTime * sampleRate)));
+
+    return data;
+}
+
+void RateDataBuilder::publish(std::unique_ptr<RateDependentData> data)
+{
+    std::unique_ptr<RateDependentData> previous(current.exchange(data.release()));
+
+    const juce::ScopedLock sl(retireLock);
+
+    if (previous != nullptr)
+        retired.push_back(std::move(previous));
+
+    // Free every retired snapshot the audio thread is no longer holding
+    auto* held = inUseByAudioThread.load();
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+                                 [held](const auto& snapshot) { return snapshot.get() != held; }),
+                  retired.end());
+}
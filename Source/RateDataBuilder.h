@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    RateDataBuilder.h
+
+    Builder for the voices' sample-rate-dependent data in DUMUMUB wavetable synthesizer.
+    Rebuilds on a background thread and swaps the result in atomically.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BackgroundWorker.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * The voice-side data derived from the sample rate (tuning and parameter
+ * smoothing), built as one immutable snapshot. The audio thread only ever
+ * reads a published snapshot, never a half-built one.
+ *
+ * Not covered: the convolution IR is resampled by its own background job,
+ * while the effect delay lines, the limiter lookahead, the loudness meter's
+ * K-weighting filters and the live-capture pitch range are still prepared
+ * synchronously in prepareToPlay, where the host is not running the audio
+ * thread.
+ */
+struct RateDependentData
+{
+    // Samples between voice control-rate ticks
+    static constexpr int controlInterval = 32;
+
+    double sampleRate = 44100.0;
+    int maximumBlockSize = 512;
+
+    // Wavetable tuning: table phase increment per MIDI note and per Hz at this rate
+    std::array<float, 128> noteIncrements;
+    float incrementPerHz = 0.0f;
+
+    // One-pole coefficient applied once per control tick for ~20 ms parameter smoothing
+    float parameterSmoothing = 1.0f;
+};
+
+//==============================================================================
+/**
+ * Rate Data Builder - Background Build and Atomic Swap
+ *
+ * The audio thread calls acquire() once per block and uses that snapshot until
+ * the next block. The builder publishes new snapshots with an atomic exchange
+ * and only frees a retired snapshot once the audio thread has moved past it,
+ * using a single hazard pointer.
+ */
+class RateDataBuilder
+{
+public:
+    RateDataBuilder(BackgroundWorker& worker);
+    ~RateDataBuilder();
+
+    // Build synchronously (first prepareToPlay, when there is nothing to fall back on)
+    void buildNow(double sampleRate, int maximumBlockSize);
+
+    // Build on the background worker; the previous snapshot stays live until then
+    void requestRebuild(double sampleRate, int maximumBlockSize);
+
+    // Audio thread: pin the current snapshot for this block (may be nullptr before the first build)
+    const RateDependentData* acquire() noexcept;
+
+    bool hasData() const noexcept { return current.load() != nullptr; }
+
+private:
+    static std::unique_ptr<RateDependentData> build(double sampleRate, int maximumBlockSize);
+    void publish(std::unique_ptr<RateDependentData> data);
+
+    BackgroundWorker& backgroundWorker;
+
+    std::atomic<RateDependentData*> current { nullptr };
+    std::atomic<RateDependentData*> inUseByAudioThread { nullptr };
+
+    // Retired snapshots waiting for the audio thread to let go (builder side only)
+    juce::CriticalSection retireLock;
+    std::vector<std::unique_ptr<RateDependentData>> retired;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RateDataBuilder)
+};
@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.cpp
+
+    Thread marking, violation reporting and the interposed functions.
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+#include <array>
+#include <cstdio>
+
+namespace
+{
+    // Plain thread-locals only: these are read from inside malloc
+    thread_local int auditDepth = 0;
+    thread_local const void* permittedMutex = nullptr;
+    thread_local bool reporting = false;
+
+    std::array<std::atomic<juce::uint64>, RealtimeAudit::numViolations> violationCounts {};
+    std::atomic<int> reportsWritten { 0 };
+
+    const char* getViolationName(RealtimeAudit::Violation violation)
+    {
+        switch (violation)
+        {
+            case RealtimeAudit::Violation::allocation: return "allocation";
+            case RealtimeAudit::Violation::lock:       return "lock";
+            case RealtimeAudit::Violation::fileAccess: return "file access";
+        }
+        return "unknown";
+    }
+}
+
+//==============================================================================
+bool RealtimeAudit::isAudioThread()
+{
+    return auditDepth > 0;
+}
+
+void RealtimeAudit::report(Violation violation, const char* function)
+{
+    const auto index = static_cast<int>(violation);
+    if (auditDepth == 0 || reporting)
+        return;
+
+    violationCounts[static_cast<size_t>(index)].fetch_add(1, std::memory_order_relaxed);
+
+    if (reportsWritten.fetch_add(1, std::memory_order_relaxed) >= maxReports)
+        return;
+
+    // Building the report allocates and locks too, so the hooks stand down until it is written
+    // (including freeing the message, hence the inner scope)
+    reporting = true;
+
+    {
+        juce::String message;
+        message << "DUMUMUB realtime audit: " << getViolationName(violation) << " (" << function << ") on the audio thread"
+                << juce::newLine << juce::SystemStats::getStackBacktrace() << juce::newLine;
+        std::fputs(message.toRawUTF8(), stderr);
+    }
+
+    reporting = false;
+}
+
+juce::uint64 RealtimeAudit::getViolationCount()
+{
+    juce::uint64 total = 0;
+    for (const auto& count : violationCounts)
+        total += count.load(std::memory_order_relaxed);
+    return total;
+}
+
+juce::uint64 RealtimeAudit::getViolationCount(Violation violation)
+{
+    return violationCounts[static_cast<size_t>(violation)].load(std::memory_order_relaxed);
+}
+
+void RealtimeAudit::resetViolationCounts()
+{
+    for (auto& count : violationCounts)
+        count.store(0, std::memory_order_relaxed);
+    reportsWritten.store(0, std::memory_order_relaxed);
+}
+
+//==============================================================================
+RealtimeAudit::ScopedAudioThread::ScopedAudioThread()
+{
+    ++auditDepth;
+}
+
+RealtimeAudit::ScopedAudioThread::~ScopedAudioThread()
+{
+    --auditDepth;
+}
+
+// JUCE's POSIX CriticalSection holds nothing but its pthread mutex, so the two share an address
+RealtimeAudit::ScopedLockPermit::ScopedLockPermit(const juce::CriticalSection& lock)
+    : previous(permittedMutex)
+{
+    permittedMutex = &lock;
+}
+
+RealtimeAudit::ScopedLockPermit::~ScopedLockPermit()
+{
+    permittedMutex = previous;
+}
+
+//==============================================================================
+#if DUMUMUB_REALTIME_AUDIT
+
+#if JUCE_LINUX
+#include <dlfcn.h>
+#include <cstdarg>
+#include <unistd.h>
+
+// glibc exports its allocator under these names, so the hooks can forward
+// without dlsym (which itself allocates)
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void __libc_free(void* pointer);
+}
+
+namespace
+{
+    inline void check(RealtimeAudit::Violation violation, const char* function)
+    {
+        if (auditDepth > 0)
+            RealtimeAudit::report(violation, function);
+    }
+
+    using MutexLockFunction = int (*)(pthread_mutex_t*);
+    using OpenFunction = int (*)(const char*, int, ...);
+    using OpenAtFunction = int (*)(int, const char*, int, ...);
+    using FileOpenFunction = FILE* (*)(const char*, const char*);
+    using ReadFunction = ssize_t (*)(int, void*, size_t);
+    using WriteFunction = ssize_t (*)(int, const void*, size_t);
+
+    // Constant-initialised, then resolved on first call: a hook can run before this
+    // file's dynamic initialisers would have
+    std::atomic<MutexLockFunction> nextMutexLock { nullptr };
+    std::atomic<OpenFunction> nextOpen { nullptr };
+    std::atomic<OpenFunction> nextOpen64 { nullptr };
+    std::atomic<OpenAtFunction> nextOpenAt { nullptr };
+    std::atomic<FileOpenFunction> nextFileOpen { nullptr };
+    std::atomic<FileOpenFunction> nextFileOpen64 { nullptr };
+    std::atomic<ReadFunction> nextRead { nullptr };
+    std::atomic<WriteFunction> nextWrite { nullptr };
+
+    template <typename Function>
+    Function findNext(std::atomic<Function>& next, const char* name)
+    {
+        auto function = next.load(std::memory_order_relaxed);
+        if (function == nullptr)
+        {
+            // dlsym may allocate; that is the audit's own doing, not the caller's
+            const bool wasReporting = reporting;
+            reporting = true;
+            function = reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+            reporting = wasReporting;
+            next.store(function, std::memory_order_relaxed);
+        }
+        return function;
+    }
+
+    // The mode argument is only present when a file may be created
+    unsigned int takeMode(int flags, va_list args)
+    {
+        return (flags & (0100 | 020000000)) != 0 ? va_arg(args, unsigned int) : 0u;  // O_CREAT | O_TMPFILE
+    }
+}
+
+extern "C"
+{
+    void* malloc(size_t size)
+    {
+        check(RealtimeAudit::Violation::allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size)
+    {
+        check(RealtimeAudit::Violation::allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* pointer, size_t size)
+    {
+        check(RealtimeAudit::Violation::allocation, "realloc");
+        return __libc_realloc(pointer, size);
+    }
+
+    void free(void* pointer)
+    {
+        if (pointer != nullptr)
+            check(RealtimeAudit::Violation::allocation, "free");
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t* mutex)
+    {
+        if (mutex != permittedMutex)
+            check(RealtimeAudit::Violation::lock, "pthread_mutex_lock");
+        return findNext(nextMutexLock, "pthread_mutex_lock")(mutex);
+    }
+
+    int open(const char* path, int flags, ...)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "open");
+        va_list args;
+        va_start(args, flags);
+        const auto mode = takeMode(flags, args);
+        va_end(args);
+        return findNext(nextOpen, "open")(path, flags, mode);
+    }
+
+    int open64(const char* path, int flags, ...)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "open64");
+        va_list args;
+        va_start(args, flags);
+        const auto mode = takeMode(flags, args);
+        va_end(args);
+        return findNext(nextOpen64, "open64")(path, flags, mode);
+    }
+
+    int openat(int directory, const char* path, int flags, ...)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "openat");
+        va_list args;
+        va_start(args, flags);
+        const auto mode = takeMode(flags, args);
+        va_end(args);
+        return findNext(nextOpenAt, "openat")(directory, path, flags, mode);
+    }
+
+    FILE* fopen(const char* path, const char* mode)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "fopen");
+        return findNext(nextFileOpen, "fopen")(path, mode);
+    }
+
+    FILE* fopen64(const char* path, const char* mode)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "fopen64");
+        return findNext(nextFileOpen64, "fopen64")(path, mode);
+    }
+
+    // Pipes and sockets count too: any read or write can block on the kernel
+    ssize_t read(int descriptor, void* data, size_t size)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "read");
+        return findNext(nextRead, "read")(descriptor, data, size);
+    }
+
+    ssize_t write(int descriptor, const void* data, size_t size)
+    {
+        check(RealtimeAudit::Violation::fileAccess, "write");
+        return findNext(nextWrite, "write")(descriptor, data, size);
+    }
+}
+
+#else
+
+// No portable interposition elsewhere: replace the global allocation operators
+// (locks and file access are not trapped on these platforms)
+#include <new>
+#include <cstdlib>
+
+namespace
+{
+    void* auditedAllocate(std::size_t size, const char* function)
+    {
+        if (auditDepth > 0)
+            RealtimeAudit::report(RealtimeAudit::Violation::allocation, function);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void auditedFree(void* pointer, const char* function)
+    {
+        if (pointer != nullptr && auditDepth > 0)
+            RealtimeAudit::report(RealtimeAudit::Violation::allocation, function);
+        std::free(pointer);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* pointer = auditedAllocate(size, "operator new"))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* pointer = auditedAllocate(size, "operator new[]"))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept      { return auditedAllocate(size, "operator new"); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept    { return auditedAllocate(size, "operator new[]"); }
+void operator delete(void* pointer) noexcept                              { auditedFree(pointer, "operator delete"); }
+void operator delete[](void* pointer) noexcept                            { auditedFree(pointer, "operator delete[]"); }
+void operator delete(void* pointer, std::size_t) noexcept                 { auditedFree(pointer, "operator delete"); }
+void operator delete[](void* pointer, std::size_t) noexcept               { auditedFree(pointer, "operator delete[]"); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept       { auditedFree(pointer, "operator delete"); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept     { auditedFree(pointer, "operator delete[]"); }
+
+#endif
+#endif
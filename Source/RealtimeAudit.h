@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    RealtimeAudit.h
+
+    Debug-build audit of allocations, locks and file access on the
+    DUMUMUB audio thread.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+
+// Build with DUMUMUB_REALTIME_AUDIT=1 (debug builds only) to install the hooks
+#ifndef DUMUMUB_REALTIME_AUDIT
+ #define DUMUMUB_REALTIME_AUDIT 0
+#endif
+
+// Never interpose the allocator in a release build, whatever the flag says
+#if DUMUMUB_REALTIME_AUDIT && ! JUCE_DEBUG
+ #undef DUMUMUB_REALTIME_AUDIT
+ #define DUMUMUB_REALTIME_AUDIT 0
+#endif
+
+//==============================================================================
+/**
+ * Realtime Audit - Audio-Thread Violation Trap
+ *
+ * processBlock marks its thread for the length of the block. While a thread
+ * is marked, every call into the hooked functions is a violation: on Linux
+ * malloc/calloc/realloc/free (which operator new and HeapBlock both reach),
+ * pthread_mutex_lock (every CriticalSection), open/openat/fopen and
+ * read/write are interposed; elsewhere the global operator new/delete are
+ * replaced. Every violation is counted; the first maxReports are also written
+ * to stderr with a stack backtrace, so a bad loop cannot flood it.
+ *
+ * The forwarding targets are looked up on first use rather than during
+ * static initialisation, since other translation units may allocate or open
+ * files before this one's globals would have been constructed.
+ *
+ * The hooks live in the binary that links this file, so they see every call
+ * in the Standalone build; inside a plugin the host's allocator and libc may
+ * resolve first. With the flag off the hooks and scopes compile to nothing.
+ *
+ * RealtimeAuditTest.cpp registers a juce::UnitTest (category "DUMUMUB") that
+ * renders every engine and output stage under the audit and expects no
+ * violations; run it with juce::UnitTestRunner in a build with the flag on.
+ */
+class RealtimeAudit
+{
+public:
+    enum class Violation { allocation = 0, lock, fileAccess };
+    static constexpr int numViolations = 3;
+    static constexpr int maxReports = 32;
+
+    // True while the calling thread is inside an audited block
+    static bool isAudioThread();
+
+    // Called by the hooks; counts and reports unless already reporting
+    static void report(Violation violation, const char* function);
+
+    static juce::uint64 getViolationCount();
+    static juce::uint64 getViolationCount(Violation violation);
+    static void resetViolationCounts();
+
+    //==============================================================================
+    // Marks the calling thread as the audio thread for the enclosing scope
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioThread)
+    };
+
+    // Allows locking one known, normally uncontended CriticalSection for the enclosing
+    // scope (the synthesiser's own lock in renderNextBlock); every other lock still reports
+    class ScopedLockPermit
+    {
+    public:
+        explicit ScopedLockPermit(const juce::CriticalSection& lock);
+        ~ScopedLockPermit();
+
+    private:
+        const void* const previous;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedLockPermit)
+    };
+
+private:
+    RealtimeAudit() = delete;
+};
+
+// Audit the rest of the enclosing scope (expand to nothing when compiled out)
+#if DUMUMUB_REALTIME_AUDIT
+ #define DUMUMUB_REALTIME_AUDIT_SCOPE() \
+    const RealtimeAudit::ScopedAudioThread realtimeAuditScope
+ #define DUMUMUB_REALTIME_AUDIT_PERMIT_LOCK(criticalSection) \
+    const RealtimeAudit::ScopedLockPermit realtimeAuditPermit (criticalSection)
+#else
+ #define DUMUMUB_REALTIME_AUDIT_SCOPE()
+ #define DUMUMUB_REALTIME_AUDIT_PERMIT_LOCK(criticalSection)
+#endif
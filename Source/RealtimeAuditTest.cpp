@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    RealtimeAuditTest.cpp
+
+    Render harness that plays every engine and output stage under the
+    realtime audit and expects a clean audio thread.
+
+  ==============================================================================
+*/
+
+#include "RealtimeAudit.h"
+
+#if DUMUMUB_REALTIME_AUDIT
+
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+ * Realtime Audit Render Test
+ *
+ * Switches on everything with an audio-thread path (convolution with a
+ * written impulse, the three effects, soft clipper and limiter, live capture
+ * fed from a sidechain sine, sub and noise layers), prepares the processor
+ * and plays chords through processBlock in wavetable with phase modulation,
+ * granular and additive modes, across keyswitched zones and as MPE notes
+ * with per-note expression. A bounce of the held chord runs while the live
+ * voices keep rendering. Any allocation, lock or file access counted on the
+ * audio thread fails the test.
+ */
+class RealtimeAuditTest  : public juce::UnitTest
+{
+public:
+    RealtimeAuditTest() : juce::UnitTest("Realtime audit render", "DUMUMUB") {}
+
+    void runTest() override
+    {
+        beginTest("Every engine and stage renders without audio-thread violations");
+
+        DUMUMUB003AudioProcessor processor;
+        juce::TemporaryFile impulse(".wav");
+        expect(writeImpulse(impulse.getFile()), "Could not write the test impulse");
+
+        processor.enableAllBuses();
+        processor.setAudioPath(impulse.getFile().getFullPathName());
+        processor.setAudioFromPath();
+        processor.setConvolutionEnabled(true);
+        processor.setConvolutionMix(0.3f);
+        for (const auto effect : { EffectsChain::chorus, EffectsChain::delay, EffectsChain::reverb })
+            processor.getEffects().setEnabled(effect, true);
+        processor.setSoftClipperEnabled(true);
+        processor.setLimiterEnabled(true);
+        processor.setLiveCaptureEnabled(true);
+        processor.setSubLevel(0.3f);
+        processor.setNoiseLevel(0.1f);
+
+        processor.prepareToPlay(sampleRate, blockSize);
+        buffer.setSize(juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels()), blockSize);
+
+        // Let the impulse and rate-data jobs land, so convolution is live for the whole render
+        juce::Thread::sleep(500);
+        RealtimeAudit::resetViolationCounts();
+
+        using Mode = DUMUMUB003AudioProcessor::OscillatorMode;
+        using Operator = DUMUMUB003AudioProcessor::OperatorMode;
+
+        processor.setOperatorMode(Operator::phaseModulation);
+        processor.setOperatorIndex(2.0f);
+        playChord(processor, 1);
+        processor.setOperatorMode(Operator::off);
+
+        processor.setOscillatorMode(Mode::granular);
+        playChord(processor, 1);
+
+        processor.setOscillatorMode(Mode::additive);
+        playChord(processor, 1);
+
+        processor.setOscillatorMode(Mode::wavetable);
+
+        // Zones in two sets, switched into the second by a keyswitch mid-stream
+        auto& zones = processor.getZones();
+        zones.setKeyswitchesEnabled(true);
+        processor.addZoneFromEditor(0, { 0, 59, 1, 127 });
+        processor.addZoneFromEditor(1, { 60, 127, 1, 127 });
+        playChord(processor, 1);
+        {
+            juce::MidiBuffer midi;
+            midi.addEvent(juce::MidiMessage::noteOn(1, zones.getKeyswitchBase() + 1, 0.8f), 0);
+            midi.addEvent(juce::MidiMessage::noteOff(1, zones.getKeyswitchBase() + 1), blockSize / 2);
+            renderBlocks(processor, midi, 1);
+        }
+        playChord(processor, 1);
+        zones.setKeyswitchesEnabled(false);
+        processor.clearZoneSet(0);
+        processor.clearZoneSet(1);
+
+        // MPE lower zone: one note per member channel, each with its own bend, pressure and timbre
+        processor.setMPEEnabled(true);
+        processor.setMPEZone(true);
+        playMPENotes(processor);
+        processor.setMPEEnabled(false);
+
+        // Bounce the held chord on the long-job worker while the live voices keep rendering
+        {
+            juce::MidiBuffer midi;
+            for (const int note : chord)
+                midi.addEvent(juce::MidiMessage::noteOn(1, note, 0.8f), 0);
+            renderBlocks(processor, midi, 4);
+
+            expect(processor.bounceToTable(), "Bounce did not start");
+            for (int block = 0; block < 2000 && processor.isBouncing(); ++block)
+            {
+                renderBlocks(processor, {}, 1);
+                juce::Thread::sleep(1);
+            }
+            expect(!processor.isBouncing(), "Bounce did not finish");
+
+            midi.clear();
+            for (const int note : chord)
+                midi.addEvent(juce::MidiMessage::noteOff(1, note), 0);
+            renderBlocks(processor, midi, releaseBlocks);
+        }
+
+        processor.setLiveCaptureEnabled(false);
+        processor.releaseResources();
+
+        expectEquals(static_cast<int>(RealtimeAudit::getViolationCount(RealtimeAudit::Violation::allocation)), 0, "Allocations on the audio thread");
+        expectEquals(static_cast<int>(RealtimeAudit::getViolationCount(RealtimeAudit::Violation::lock)), 0, "Locks on the audio thread");
+        expectEquals(static_cast<int>(RealtimeAudit::getViolationCount(RealtimeAudit::Violation::fileAccess)), 0, "File access on the audio thread");
+        expect(RealtimeAudit::getViolationCount() == 0, "Audio-thread violations (see the stderr reports)");
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int sustainBlocks = 96;    // About half a second
+    static constexpr int releaseBlocks = 48;
+    static constexpr int chord[] = { 48, 55, 60, 64 };
+
+    // Decaying stereo noise, long enough for several convolution partitions
+    static bool writeImpulse(const juce::File& file)
+    {
+        constexpr int length = 12000;
+        juce::AudioBuffer<float> samples(2, length);
+        juce::Random random(1);
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < length; ++i)
+                samples.setSample(channel, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp(-6.0f * i / length));
+
+        juce::WavAudioFormat format;
+        std::unique_ptr<juce::AudioFormatWriter> writer(format.createWriterFor(new juce::FileOutputStream(file), sampleRate, 2, 24, {}, 0));
+        return writer != nullptr && writer->writeFromAudioSampleBuffer(samples, 0, length);
+    }
+
+    // The sidechain shares the first channels with the output, so each block starts as input
+    void renderBlocks(DUMUMUB003AudioProcessor& processor, const juce::MidiBuffer& midi, int numBlocks)
+    {
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float sample = 0.5f * static_cast<float>(std::sin(sidechainPhase));
+                sidechainPhase = std::fmod(sidechainPhase + juce::MathConstants<double>::twoPi * 110.0 / sampleRate, juce::MathConstants<double>::twoPi);
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.setSample(channel, i, sample);
+            }
+
+            // Only the first block carries the events
+            blockMidi.clear();
+            if (block == 0)
+                blockMidi.addEvents(midi, 0, blockSize, 0);
+
+            processor.processBlock(buffer, blockMidi);
+        }
+    }
+
+    void playChord(DUMUMUB003AudioProcessor& processor, int channel)
+    {
+        juce::MidiBuffer midi;
+        for (const int note : chord)
+            midi.addEvent(juce::MidiMessage::noteOn(channel, note, 0.8f), 0);
+        renderBlocks(processor, midi, sustainBlocks);
+
+        midi.clear();
+        for (const int note : chord)
+            midi.addEvent(juce::MidiMessage::noteOff(channel, note), 0);
+        renderBlocks(processor, midi, releaseBlocks);
+    }
+
+    void playMPENotes(DUMUMUB003AudioProcessor& processor)
+    {
+        juce::MidiBuffer midi;
+        for (int i = 0; i < 4; ++i)
+            midi.addEvent(juce::MidiMessage::noteOn(i + 2, chord[i], 0.8f), 0);
+        renderBlocks(processor, midi, 4);
+
+        for (int step = 0; step < sustainBlocks; ++step)
+        {
+            midi.clear();
+            for (int i = 0; i < 4; ++i)
+            {
+                const int channel = i + 2;
+                midi.addEvent(juce::MidiMessage::pitchWheel(channel, 8192 + (step * 64 * (i + 1)) % 4096), 0);
+                midi.addEvent(juce::MidiMessage::channelPressureChange(channel, (step + i * 16) % 128), 0);
+                midi.addEvent(juce::MidiMessage::controllerEvent(channel, 74, (step * 2 + i * 8) % 128), 0);
+            }
+            renderBlocks(processor, midi, 1);
+        }
+
+        midi.clear();
+        for (int i = 0; i < 4; ++i)
+            midi.addEvent(juce::MidiMessage::noteOff(i + 2, chord[i]), 0);
+        renderBlocks(processor, midi, releaseBlocks);
+    }
+
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer blockMidi;
+    double sidechainPhase = 0.0;
+};
+
+static RealtimeAuditTest realtimeAuditTest;
+
+#endif
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+    ScopeBuffer.h
+
+    Lock-free output capture for the DUMUMUB oscilloscope display.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+ * Scope Buffer - Single-Writer Ring of Raw Output Samples
+ *
+ * The audio thread copies each output block into a stereo ring and
+ * publishes the new write position with a release store; nothing else
+ * happens there, and nothing at all while no editor is attached.
+ *
+ * The GUI takes a snapshot of the most recent samples, finds a rising
+ * zero crossing so the trace stays still from frame to frame, and reduces
+ * the window to one min/max pair per pixel column. The ring is far longer
+ * than any snapshot, so the writer never reaches the samples being read.
+ * Other readers (the spectrum analyser) can copy the newest samples too.
+ */
+class ScopeBuffer
+{
+public:
+    static constexpr int capacity = 1 << 14;
+    static constexpr int numChannels = 2;
+
+    // Samples shown across the scope, and how far back a trigger is searched for
+    static constexpr int displayLength = 2048;
+    static constexpr int snapshotLength = displayLength * 2;
+
+    // One pixel column of the decimated trace
+    struct Column
+    {
+        float minimum = 0.0f;
+        float maximum = 0.0f;
+    };
+
+    ScopeBuffer()
+    {
+        for (auto& channel : ring)
+            channel.assign(capacity, 0.0f);
+    }
+
+    // Editor attach/detach; the audio thread skips the copy while inactive
+    void setActive(bool shouldBeActive) { active.store(shouldBeActive, std::memory_order_relaxed); }
+    bool isActive() const { return active.load(std::memory_order_relaxed); }
+
+    // Audio thread: append a block (missing channels repeat the first)
+    void push(const juce::AudioBuffer<float>& buffer)
+    {
+        if (!isActive() || buffer.getNumChannels() == 0)
+            return;
+
+        const int numSamples = juce::jmin(buffer.getNumSamples(), capacity);
+        const auto start = writePosition.load(std::memory_order_relaxed);
+        const int offset = static_cast<int>(start & (capacity - 1));
+        const int firstPart = juce::jmin(numSamples, capacity - offset);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const float* source = buffer.getReadPointer(juce::jmin(channel, buffer.getNumChannels() - 1));
+            float* destination = ring[static_cast<size_t>(channel)].data();
+            juce::FloatVectorOperations::copy(destination + offset, source, firstPart);
+            juce::FloatVectorOperations::copy(destination, source + firstPart, numSamples - firstPart);
+        }
+
+        writePosition.store(start + static_cast<juce::uint64>(numSamples), std::memory_order_release);
+    }
+
+    // Any non-audio thread: samples appended so far, to tell whether the ring has moved on
+    juce::uint64 getWritePosition() const { return writePosition.load(std::memory_order_acquire); }
+
+    //==============================================================================
+    // GUI thread: reduce the latest triggered window of each channel to one column per
+    // pixel. Returns false until the ring holds a full snapshot.
+    bool extract(std::array<std::vector<Column>, numChannels>& columns, int width)
+    {
+        const auto end = writePosition.load(std::memory_order_acquire);
+        if (end < static_cast<juce::uint64>(snapshotLength) || width <= 0)
+            return false;
+
+        // Copy the snapshot out of the ring first so the search reads stable data
+        const int start = static_cast<int>((end - snapshotLength) & (capacity - 1));
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < snapshotLength; ++i)
+                snapshot[static_cast<size_t>(channel)][static_cast<size_t>(i)] = ring[static_cast<size_t>(channel)][static_cast<size_t>((start + i) & (capacity - 1))];
+
+        const int trigger = findTrigger();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            decimate(snapshot[static_cast<size_t>(channel)].data() + trigger, columns[static_cast<size_t>(channel)], width);
+
+        return true;
+    }
+
+    // Any non-audio thread: copy the newest numSamples (at most a quarter of the ring) of
+    // each channel. Returns false until that many have been written.
+    bool copyLatest(float* left, float* right, int numSamples) const
+    {
+        jassert(numSamples <= capacity / 4);
+
+        const auto end = writePosition.load(std::memory_order_acquire);
+        if (end < static_cast<juce::uint64>(numSamples))
+            return false;
+
+        const int start = static_cast<int>((end - static_cast<juce::uint64>(numSamples)) & (capacity - 1));
+        const int firstPart = juce::jmin(numSamples, capacity - start);
+        std::copy(ring[0].begin() + start, ring[0].begin() + start + firstPart, left);
+        std::copy(ring[0].begin(), ring[0].begin() + (numSamples - firstPart), left + firstPart);
+        std::copy(ring[1].begin() + start, ring[1].begin() + start + firstPart, right);
+        std::copy(ring[1].begin(), ring[1].begin() + (numSamples - firstPart), right + firstPart);
+        return true;
+    }
+
+private:
+    // Latest rising zero crossing of the mid signal that still leaves a full display window
+    // after it. The trigger only arms once the signal has gone clearly negative, so noise
+    // around zero does not retrigger. Falls back to the newest window (free-running).
+    int findTrigger() const
+    {
+        constexpr float hysteresis = 0.01f;
+        const int latest = snapshotLength - displayLength;
+        int trigger = latest;
+        bool armed = false;
+
+        for (int i = 1; i <= latest; ++i)
+        {
+            const float mid = snapshot[0][static_cast<size_t>(i)] + snapshot[1][static_cast<size_t>(i)];
+            if (mid < -hysteresis)
+                armed = true;
+            else if (armed && mid > 0.0f)
+            {
+                trigger = i;
+                armed = false;
+            }
+        }
+
+        return trigger;
+    }
+
+    static void decimate(const float* samples, std::vector<Column>& columns, int width)
+    {
+        columns.resize(static_cast<size_t>(width));
+
+        for (int x = 0; x < width; ++x)
+        {
+            const int first = x * displayLength / width;
+            const int last = juce::jmax(first + 1, (x + 1) * displayLength / width);
+
+            auto& column = columns[static_cast<size_t>(x)];
+            juce::FloatVectorOperations::findMinAndMax(samples + first, last - first, column.minimum, column.maximum);
+        }
+    }
+
+    std::array<std::vector<float>, numChannels> ring;
+    std::atomic<juce::uint64> writePosition { 0 };
+    std::atomic<bool> active { false };
+
+    // GUI-side scratch
+    std::array<std::array<float, snapshotLength>, numChannels> snapshot {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ScopeBuffer)
+};
@@ -0,0 +1,119 @@
+/*
+  ==============================================================================
+
+    SpectralMorph.cpp
+
+    Table analysis, frame precomputation and lookup for the spectral morph.
+
+  ==============================================================================
+*/
+
+#include "SpectralMorph.h"
+
+//==============================================================================
+SpectralMorph::SpectralMorph()
+{
+    blendScratch.assign(tableSize * 2, 0.0f);
+}
+
+void SpectralMorph::build(const Table& from, const Table& to)
+{
+    // Everything is rendered locally and swapped in at the end, so lookups never wait on FFTs
+    const juce::dsp::FFT buildFFT(10);
+    std::vector<float> scratch(tableSize * 2, 0.0f);
+    Spectrum fromSpectrum, toSpectrum;
+
+    analyse(from, buildFFT, scratch.data(), fromSpectrum);
+    analyse(to, buildFFT, scratch.data(), toSpectrum);
+
+    std::vector<Table> built(numSteps);
+    for (int step = 0; step < numSteps; ++step)
+        synthesise(fromSpectrum, toSpectrum, static_cast<float>(step) / (numSteps - 1), buildFFT, scratch.data(), built[static_cast<size_t>(step)]);
+
+    const juce::ScopedLock sl(framesLock);
+    frames.swap(built);
+}
+
+bool SpectralMorph::isBuilt() const
+{
+    const juce::ScopedLock sl(framesLock);
+    return !frames.empty();
+}
+
+bool SpectralMorph::lookup(float position, Table& output) const
+{
+    const juce::ScopedLock sl(framesLock);
+    if (frames.empty())
+        return false;
+
+    const float scaled = juce::jlimit(0.0f, 1.0f, position) * (numSteps - 1);
+    const int index = juce::jmin(static_cast<int>(scaled), numSteps - 2);
+    const float fraction = scaled - index;
+
+    const auto& lower = frames[static_cast<size_t>(index)];
+    const auto& upper = frames[static_cast<size_t>(index + 1)];
+    for (int i = 0; i < tableSize; ++i)
+        output[static_cast<size_t>(i)] = lower[static_cast<size_t>(i)] + fraction * (upper[static_cast<size_t>(i)] - lower[static_cast<size_t>(i)]);
+
+    return true;
+}
+
+void SpectralMorph::blend(const Table& from, const Table& to, float position, Table& output)
+{
+    Spectrum fromSpectrum, toSpectrum;
+    analyse(from, fft, blendScratch.data(), fromSpectrum);
+    analyse(to, fft, blendScratch.data(), toSpectrum);
+    synthesise(fromSpectrum, toSpectrum, juce::jlimit(0.0f, 1.0f, position), fft, blendScratch.data(), output);
+}
+
+//==============================================================================
+void SpectralMorph::analyse(const Table& table, const juce::dsp::FFT& fft, float* scratch, Spectrum& spectrum)
+{
+    std::copy(table.begin(), table.end(), scratch);
+    std::fill(scratch + tableSize, scratch + tableSize * 2, 0.0f);
+    fft.performRealOnlyForwardTransform(scratch, true);
+
+    for (int bin = 0; bin <= tableSize / 2; ++bin)
+    {
+        const float re = scratch[bin * 2];
+        const float im = scratch[bin * 2 + 1];
+        spectrum.magnitude[static_cast<size_t>(bin)] = std::sqrt(re * re + im * im);
+        spectrum.phase[static_cast<size_t>(bin)] = std::atan2(im, re);
+    }
+}
+
+void SpectralMorph::synthesise(const Spectrum& from, const Spectrum& to, float position,
+                               const juce::dsp::FFT& fft, float* scratch, Table& output)
+{
+    std::fill(scratch, scratch + tableSize * 2, 0.0f);
+
+    for (int bin = 0; bin <= tableSize / 2; ++bin)
+    {
+        const auto index = static_cast<size_t>(bin);
+        const float magnitude = from.magnitude[index] + position * (to.magnitude[index] - from.magnitude[index]);
+
+        // Rotate by the wrapped difference, so each bin takes the shorter way round
+        float turn = to.phase[index] - from.phase[index];
+        if (turn > juce::MathConstants<float>::pi)
+            turn -= juce::MathConstants<float>::twoPi;
+        else if (turn < -juce::MathConstants<float>::pi)
+            turn += juce::MathConstants<float>::twoPi;
+
+        const float phase = from.phase[index] + position * turn;
+        scratch[bin * 2] = magnitude * std::cos(phase);
+        scratch[bin * 2 + 1] = magnitude * std::sin(phase);
+    }
+
+    // DC and Nyquist are real, so blend their signed values rather than rotating them
+    for (const int bin : { 0, tableSize / 2 })
+    {
+        const auto index = static_cast<size_t>(bin);
+        const float fromValue = from.magnitude[index] * std::cos(from.phase[index]);
+        const float toValue = to.magnitude[index] * std::cos(to.phase[index]);
+        scratch[bin * 2] = fromValue + position * (toValue - fromValue);
+        scratch[bin * 2 + 1] = 0.0f;
+    }
+
+    fft.performRealOnlyInverseTransform(scratch);
+    std::copy(scratch, scratch + tableSize, output.begin());
+}
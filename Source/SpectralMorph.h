@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    SpectralMorph.h
+
+    Magnitude/phase morphing between two DUMUMUB wavetables.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Spectral Morph - Precomputed Magnitude and Phase-Rotation Interpolation
+ *
+ * Interpolates two tables bin by bin: magnitudes linearly, and each bin's
+ * phasor rotated from the source phase toward the target along the shorter
+ * arc. Both spectra share the table's own phase reference, so every bin
+ * turns by less than half a cycle and partials glide between shapes rather
+ * than cancelling as they do in a time-domain (or complex) average.
+ *
+ * build() takes the FFT of both sources once and renders numSteps frames
+ * across the morph; lookup() then crossfades the two nearest frames, so a
+ * morph knob never runs an FFT. Building allocates and is meant for a
+ * background thread; lookups are safe from any non-audio thread meanwhile.
+ * blend() is a one-off morph for editor actions (message thread only).
+ */
+class SpectralMorph
+{
+public:
+    static constexpr int tableSize = 1024;
+    static constexpr int numSteps = 64;
+
+    using Table = std::array<float, tableSize>;
+
+    SpectralMorph();
+
+    // Precompute the frames between two sources (background thread)
+    void build(const Table& from, const Table& to);
+    bool isBuilt() const;
+
+    // Morphed table at position 0 (from) .. 1 (to); false if nothing has been built
+    bool lookup(float position, Table& output) const;
+
+    // Single morph without the precomputed frames (message thread)
+    void blend(const Table& from, const Table& to, float position, Table& output);
+
+private:
+    struct Spectrum
+    {
+        std::array<float, tableSize / 2 + 1> magnitude;
+        std::array<float, tableSize / 2 + 1> phase;     // Wrapped to (-pi, pi]
+    };
+
+    static void analyse(const Table& table, const juce::dsp::FFT& fft, float* scratch, Spectrum& spectrum);
+    static void synthesise(const Spectrum& from, const Spectrum& to, float position,
+                           const juce::dsp::FFT& fft, float* scratch, Table& output);
+
+    juce::dsp::FFT fft { 10 };
+    std::vector<float> blendScratch;
+
+    juce::CriticalSection framesLock;
+    std::vector<Table> frames;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectralMorph)
+};
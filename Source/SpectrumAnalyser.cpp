@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.cpp
+
+    Windowed FFT, log-frequency banding and point generation.
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyser.h"
+
+//==============================================================================
+SpectrumAnalyser::SpectrumAnalyser()
+{
+    window.resize(fftSize);
+    for (int i = 0; i < fftSize; ++i)
+        window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * i / fftSize);
+
+    left.assign(fftSize, 0.0f);
+    right.assign(fftSize, 0.0f);
+    frame.assign(fftSize * 2, 0.0f);
+    tableScratch.assign(AdditiveOscillator::frameSize * 2, 0.0f);
+    smoothed.fill(0.0f);
+
+    working.output.reserve(numBands);
+    working.harmonicsL.reserve(AdditiveOscillator::maxPartials);
+    working.harmonicsR.reserve(AdditiveOscillator::maxPartials);
+}
+
+void SpectrumAnalyser::analyse(const ScopeBuffer& scope, double sampleRate,
+                               const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    working.output.clear();
+
+    if (sampleRate > 0.0 && scope.copyLatest(left.data(), right.data(), fftSize))
+    {
+        if (sampleRate != bandRate)
+            updateBands(sampleRate);
+
+        // Windowed mid signal
+        for (int i = 0; i < fftSize; ++i)
+            frame[static_cast<size_t>(i)] = 0.5f * (left[static_cast<size_t>(i)] + right[static_cast<size_t>(i)]) * window[static_cast<size_t>(i)];
+        std::fill(frame.begin() + fftSize, frame.end(), 0.0f);
+
+        fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+        buildOutputPoints(working.output);
+    }
+
+    buildHarmonicPoints(tableL, working.harmonicsL);
+    buildHarmonicPoints(tableR, working.harmonicsR);
+
+    // Swap the finished frame in; the GUI never waits on the analysis itself
+    const juce::SpinLock::ScopedLockType sl(viewLock);
+    std::swap(working, latest);
+    latestIsNew = true;
+}
+
+bool SpectrumAnalyser::getView(View& view)
+{
+    // Only pointers change hands under the lock; nothing is copied
+    const juce::SpinLock::ScopedLockType sl(viewLock);
+    if (!latestIsNew)
+        return false;
+
+    std::swap(view, latest);
+    latestIsNew = false;
+    return true;
+}
+
+//==============================================================================
+void SpectrumAnalyser::updateBands(double sampleRate)
+{
+    bandRate = sampleRate;
+
+    const double nyquist = sampleRate * 0.5;
+    const double ratio = nyquist / lowestFrequency;
+    const double binWidth = sampleRate / fftSize;
+
+    for (int band = 0; band <= numBands; ++band)
+    {
+        const double frequency = lowestFrequency * std::pow(ratio, static_cast<double>(band) / numBands);
+        bandEdges[static_cast<size_t>(band)] = juce::jlimit(0, fftSize / 2, static_cast<int>(frequency / binWidth));
+    }
+
+    // Fractional bin at each band's centre, for bands narrower than a bin
+    for (int band = 0; band < numBands; ++band)
+    {
+        const double frequency = lowestFrequency * std::pow(ratio, (band + 0.5) / numBands);
+        bandCentres[static_cast<size_t>(band)] = static_cast<float>(frequency / binWidth);
+    }
+
+    smoothed.fill(0.0f);
+}
+
+void SpectrumAnalyser::buildOutputPoints(std::vector<juce::Point<float>>& points)
+{
+    // Hann coherent gain is 0.5 and the spectrum is one-sided, so a full-scale sine peaks at N / 4
+    const float scale = 4.0f / fftSize;
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        const int first = bandEdges[static_cast<size_t>(band)];
+        const int last = bandEdges[static_cast<size_t>(band + 1)];
+
+        float magnitude = 0.0f;
+        if (last > first)
+        {
+            for (int bin = first; bin < last; ++bin)
+                magnitude = juce::jmax(magnitude, frame[static_cast<size_t>(bin)]);
+        }
+        else
+        {
+            // Low bands fall between bins: interpolate at the band centre
+            const float position = bandCentres[static_cast<size_t>(band)];
+            const int bin = juce::jmin(static_cast<int>(position), fftSize / 2 - 1);
+            const float fraction = position - bin;
+            magnitude = frame[static_cast<size_t>(bin)] + fraction * (frame[static_cast<size_t>(bin + 1)] - frame[static_cast<size_t>(bin)]);
+        }
+        magnitude *= scale;
+
+        // Instant rise, smooth fall
+        auto& shown = smoothed[static_cast<size_t>(band)];
+        shown = magnitude > shown ? magnitude : shown * 0.8f + magnitude * 0.2f;
+
+        points.push_back({ static_cast<float>(band) / (numBands - 1), toY(shown) });
+    }
+}
+
+void SpectrumAnalyser::buildHarmonicPoints(const std::array<float, 1024>& table, std::vector<juce::Point<float>>& points)
+{
+    points.clear();
+    AdditiveOscillator::analyse(table, tableFFT, tableScratch.data(), tableSpectrum);
+
+    const float logRange = std::log(static_cast<float>(AdditiveOscillator::maxPartials));
+    const float minimumAmplitude = juce::Decibels::decibelsToGain(floorDecibels);
+    for (int harmonic = 1; harmonic <= AdditiveOscillator::maxPartials; ++harmonic)
+    {
+        const float amplitude = tableSpectrum.amplitude[static_cast<size_t>(harmonic)];
+        if (amplitude <= minimumAmplitude)
+            continue;
+
+        points.push_back({ std::log(static_cast<float>(harmonic)) / logRange, toY(amplitude) });
+    }
+}
+
+float SpectrumAnalyser::toY(float magnitude)
+{
+    const float decibels = juce::Decibels::gainToDecibels(magnitude, floorDecibels);
+    return juce::jlimit(0.0f, 1.0f, decibels / floorDecibels);
+}
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyser.h
+
+    Background spectrum analysis for the DUMUMUB canvas.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ScopeBuffer.h"
+#include "AdditiveOscillator.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * Spectrum Analyser - Live Output and Table Harmonic Spectra
+ *
+ * Runs on the background worker. Each pass reads the newest samples the
+ * scope ring already holds (so opening the view adds nothing to the audio
+ * thread), applies a Hann window and one FFT with a plan built once, and
+ * folds the bins into log-spaced bands from 20 Hz to Nyquist. The bands
+ * rise instantly and fall smoothly between passes. The current tables are
+ * reduced to their harmonic amplitudes on the same pass.
+ *
+ * The GUI receives finished points, normalised to 0..1 on both axes
+ * (x across the view, y down from 0 dB to the floor), and only scales and
+ * strokes them.
+ */
+class SpectrumAnalyser
+{
+public:
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int numBands = 256;
+    static constexpr float floorDecibels = -96.0f;
+    static constexpr float lowestFrequency = 20.0f;
+
+    // Finished points for one frame of the view
+    struct View
+    {
+        std::vector<juce::Point<float>> output;       // Live output, log frequency
+        std::vector<juce::Point<float>> harmonicsL;   // Table harmonics 1..512, log harmonic number
+        std::vector<juce::Point<float>> harmonicsR;
+    };
+
+    SpectrumAnalyser();
+
+    // Background thread: analyse the latest output and the given tables
+    void analyse(const ScopeBuffer& scope, double sampleRate,
+                 const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+
+    // GUI thread (single consumer): swap in the newest finished view, if one has arrived since
+    // the last call, leaving the caller's old buffers for the analyser to reuse
+    bool getView(View& view);
+
+private:
+    void updateBands(double sampleRate);
+    void buildOutputPoints(std::vector<juce::Point<float>>& points);
+    void buildHarmonicPoints(const std::array<float, 1024>& table, std::vector<juce::Point<float>>& points);
+
+    static float toY(float magnitude);
+
+    // Cached FFT plans, window and band edges
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::FFT tableFFT { AdditiveOscillator::fftOrder };
+    std::vector<float> window;
+    std::array<int, numBands + 1> bandEdges {};
+    std::array<float, numBands> bandCentres {};
+    double bandRate = 0.0;
+
+    // Working storage (background thread only)
+    std::vector<float> left, right, frame, tableScratch;
+    std::array<float, numBands> smoothed {};
+    TableSpectrum tableSpectrum;
+    View working;
+
+    juce::SpinLock viewLock;
+    View latest;
+    bool latestIsNew = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyser)
+};
@@ -0,0 +1,210 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.cpp
+
+    Ring claiming, event recording and JSON streaming.
+
+  ==============================================================================
+*/
+
+#include "TraceRecorder.h"
+#include <cstring>
+
+namespace
+{
+    // The ring this thread claimed (recorders are process-wide, so one pointer is enough)
+    thread_local void* threadRing = nullptr;
+}
+
+//==============================================================================
+TraceRecorder& TraceRecorder::getInstance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+TraceRecorder::TraceRecorder() : juce::Thread("DUMUMUB Trace Flush")
+{
+    ticksPerMicrosecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()) / 1.0e6;
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    stop();
+}
+
+bool TraceRecorder::start(const juce::File& file)
+{
+    if (isRecording())
+        return false;
+
+    auto newStream = file.createOutputStream();
+    if (newStream == nullptr || !newStream->openedOk())
+        return false;
+
+    newStream->setPosition(0);
+    newStream->truncate();
+
+    // Rings are allocated on the first recording and kept, so a writer never sees them go away
+    if (rings == nullptr)
+        rings.reset(new ThreadRing[maxThreads]);
+
+    // Discard anything written after the previous recording stopped
+    flush(false);
+
+    stream = std::move(newStream);
+    traceFile = file;
+    *stream << "{\"traceEvents\":[\n";
+    firstEvent = true;
+    originTicks = juce::Time::getHighResolutionTicks();
+    dropped = 0;
+
+    recording.store(true, std::memory_order_release);
+    startThread(juce::Thread::Priority::low);
+    return true;
+}
+
+void TraceRecorder::stop()
+{
+    if (!isRecording())
+        return;
+
+    recording.store(false, std::memory_order_release);
+    stopThread(2000);
+    flush(true);
+
+    // Thread names, so the timeline shows "audio" rather than a bare index
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        const auto& ring = rings[static_cast<size_t>(i)];
+        if (!ring.claimed.load(std::memory_order_acquire))
+            continue;
+
+        *stream << (firstEvent ? "" : ",\n")
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (i + 1)
+                << ",\"args\":{\"name\":\"" << ring.label << "\"}}";
+        firstEvent = false;
+    }
+
+    *stream << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":"
+            << juce::String(static_cast<juce::int64>(getDroppedEvents())) << "}}\n";
+    stream->flush();
+    stream.reset();
+}
+
+//==============================================================================
+void TraceRecorder::addComplete(const char* category, const char* name, juce::int64 startTicks, juce::int64 endTicks, int argument)
+{
+    push({ category, name, startTicks, endTicks, argument, false });
+}
+
+void TraceRecorder::addInstant(const char* category, const char* name, int argument)
+{
+    if (!isRecording())
+        return;
+
+    const auto now = juce::Time::getHighResolutionTicks();
+    push({ category, name, now, now, argument, true });
+}
+
+void TraceRecorder::push(const Event& event)
+{
+    if (!recording.load(std::memory_order_acquire))
+        return;
+
+    auto* ring = static_cast<ThreadRing*>(threadRing);
+    if (ring == nullptr)
+    {
+        ring = claimRing(event.category);
+        if (ring == nullptr)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    const auto write = ring->writePosition.load(std::memory_order_relaxed);
+    if (write - ring->readPosition.load(std::memory_order_acquire) >= static_cast<juce::uint32>(ringSize))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[write & (ringSize - 1)] = event;
+    ring->writePosition.store(write + 1, std::memory_order_release);
+}
+
+TraceRecorder::ThreadRing* TraceRecorder::claimRing(const char* category)
+{
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        auto& ring = rings[static_cast<size_t>(i)];
+        bool expected = false;
+        if (ring.claimed.load(std::memory_order_relaxed) || !ring.claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            continue;
+
+        // Label from the first event's category; the message thread is named outright
+        const char* label = juce::MessageManager::existsAndIsCurrentThread() ? "message" : category;
+        std::strncpy(ring.label, label, sizeof(ring.label) - 1);
+
+        threadRing = &ring;
+        return &ring;
+    }
+
+    // Rings are never released, so more than maxThreads distinct threads drop their events
+    return nullptr;
+}
+
+//==============================================================================
+void TraceRecorder::run()
+{
+    while (!threadShouldExit())
+    {
+        wait(50);
+        flush(true);
+    }
+}
+
+void TraceRecorder::flush(bool write)
+{
+    for (int i = 0; i < maxThreads; ++i)
+    {
+        auto& ring = rings[static_cast<size_t>(i)];
+        if (!ring.claimed.load(std::memory_order_acquire))
+            continue;
+
+        const auto end = ring.writePosition.load(std::memory_order_acquire);
+        auto read = ring.readPosition.load(std::memory_order_relaxed);
+
+        for (; read != end; ++read)
+            if (write)
+                writeEvent(ring.events[read & (ringSize - 1)], i);
+
+        ring.readPosition.store(read, std::memory_order_release);
+    }
+}
+
+void TraceRecorder::writeEvent(const Event& event, int threadIndex)
+{
+    // Events from before the recording started (still in flight at start) are clamped to zero
+    const double timestamp = juce::jmax(0.0, (event.startTicks - originTicks) / ticksPerMicrosecond);
+
+    juce::String line;
+    line << (firstEvent ? "" : ",\n")
+         << "{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+         << "\",\"pid\":1,\"tid\":" << (threadIndex + 1)
+         << ",\"ts\":" << juce::String(timestamp, 3);
+
+    if (event.instant)
+        line << ",\"ph\":\"i\",\"s\":\"t\"";
+    else
+        line << ",\"ph\":\"X\",\"dur\":" << juce::String((event.endTicks - event.startTicks) / ticksPerMicrosecond, 3);
+
+    if (event.argument != noArgument)
+        line << ",\"args\":{\"value\":" << event.argument << "}";
+
+    line << "}";
+    *stream << line;
+    firstEvent = false;
+}
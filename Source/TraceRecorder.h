@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    TraceRecorder.h
+
+    Chrome trace / Perfetto event recorder for DUMUMUB wavetable synthesizer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <memory>
+
+// Build with DUMUMUB_TRACE=0 to compile the trace points out entirely
+#ifndef DUMUMUB_TRACE
+ #define DUMUMUB_TRACE 1
+#endif
+
+//==============================================================================
+/**
+ * Trace Recorder - Per-Thread Event Rings Flushed to Chrome Trace JSON
+ *
+ * Trace points record a name and category (both string literals, never
+ * copied), high-resolution tick times and an optional integer argument.
+ * Each thread claims one fixed ring the first time it records, so writers
+ * never share a cache line, never lock and never allocate; a full ring drops
+ * events and counts them. While recording, a low-priority thread drains
+ * every ring every 50 ms and streams the events to a JSON file that
+ * chrome://tracing and ui.perfetto.dev open directly.
+ *
+ * When not recording, a trace point costs one relaxed atomic load.
+ */
+class TraceRecorder : private juce::Thread
+{
+public:
+    static constexpr int maxThreads = 16;
+    static constexpr int ringSize = 4096;   // Events per thread, a power of two
+
+    static TraceRecorder& getInstance();
+
+    ~TraceRecorder() override;
+
+    // Message thread: start streaming to a new file, or finish the current one
+    bool start(const juce::File& file);
+    void stop();
+    bool isRecording() const { return recording.load(std::memory_order_relaxed); }
+    juce::File getFile() const { return traceFile; }
+    juce::uint64 getDroppedEvents() const { return dropped.load(std::memory_order_relaxed); }
+
+    // Any thread: record a finished span or an instant
+    void addComplete(const char* category, const char* name, juce::int64 startTicks, juce::int64 endTicks, int argument = noArgument);
+    void addInstant(const char* category, const char* name, int argument = noArgument);
+
+    static constexpr int noArgument = -1;
+
+    //==============================================================================
+    // Records the enclosing scope as one complete event
+    class ScopedEvent
+    {
+    public:
+        ScopedEvent(const char* eventCategory, const char* eventName, int eventArgument = noArgument)
+            : category(eventCategory), name(eventName), argument(eventArgument),
+              startTicks(getInstance().isRecording() ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedEvent()
+        {
+            if (startTicks != 0)
+                getInstance().addComplete(category, name, startTicks, juce::Time::getHighResolutionTicks(), argument);
+        }
+
+    private:
+        const char* const category;
+        const char* const name;
+        const int argument;
+        const juce::int64 startTicks;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedEvent)
+    };
+
+private:
+    TraceRecorder();
+
+    struct Event
+    {
+        const char* category;
+        const char* name;
+        juce::int64 startTicks;
+        juce::int64 endTicks;   // Equal to startTicks for an instant
+        int argument;
+        bool instant;
+    };
+
+    // One writer (the owning thread), one reader (the flush thread)
+    struct ThreadRing
+    {
+        std::atomic<bool> claimed { false };
+        std::atomic<juce::uint32> writePosition { 0 };
+        std::atomic<juce::uint32> readPosition { 0 };
+        char label[64] = {};
+        Event events[ringSize];
+    };
+
+    void push(const Event& event);
+    ThreadRing* claimRing(const char* category);
+
+    void run() override;
+    void flush(bool write);
+    void writeEvent(const Event& event, int threadIndex);
+
+    std::unique_ptr<ThreadRing[]> rings;
+    std::atomic<bool> recording { false };
+    std::atomic<juce::uint64> dropped { 0 };
+
+    // Flush thread state
+    juce::File traceFile;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::int64 originTicks = 0;
+    double ticksPerMicrosecond = 1.0;
+    bool firstEvent = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TraceRecorder)
+};
+
+// Trace the rest of the enclosing scope, or mark an instant (expand to nothing when compiled out)
+#if DUMUMUB_TRACE
+ #define DUMUMUB_TRACE_SCOPE(category, name) \
+    const TraceRecorder::ScopedEvent traceScope (category, name)
+ #define DUMUMUB_TRACE_SCOPE_ARG(category, name, argument) \
+    const TraceRecorder::ScopedEvent traceScope (category, name, argument)
+ #define DUMUMUB_TRACE_INSTANT(category, name, argument) \
+    TraceRecorder::getInstance().addInstant (category, name, argument)
+#else
+ #define DUMUMUB_TRACE_SCOPE(category, name)
+ #define DUMUMUB_TRACE_SCOPE_ARG(category, name, argument)
+ #define DUMUMUB_TRACE_INSTANT(category, name, argument)
+#endif
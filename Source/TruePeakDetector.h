@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+    TruePeakDetector.h
+
+    4x oversampled inter-sample peak estimation for DUMUMUB output metering
+    and limiting.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+ * True Peak Detector - 4x Polyphase Inter-Sample Peak Estimate
+ *
+ * For each input sample, takes the largest magnitude among two neighbouring
+ * samples and the three positions between them that a 4x oversampler would
+ * produce, using 8-tap Hann-windowed sinc kernels (one per phase). Results
+ * run delay samples behind the input. Every step is a vector operation over
+ * the block, and the history of one channel is kept between blocks.
+ */
+class TruePeakDetector
+{
+public:
+    static constexpr int taps = 8;
+    static constexpr int delay = taps / 2;
+
+    TruePeakDetector()
+    {
+        // Build the shared kernels here so they are never built on the audio thread
+        getKernels();
+    }
+
+    void prepare(int maximumBlockSize)
+    {
+        history.assign(static_cast<size_t>(taps - 1 + maximumBlockSize), 0.0f);
+        scratch.assign(static_cast<size_t>(maximumBlockSize), 0.0f);
+    }
+
+    void reset()
+    {
+        std::fill(history.begin(), history.end(), 0.0f);
+    }
+
+    // Fold this channel's true peaks into peaks (max with what is already there).
+    // numSamples must not exceed the prepared block size.
+    void accumulate(const float* input, int numSamples, float* peaks)
+    {
+        const int keep = taps - 1;
+        juce::FloatVectorOperations::copy(history.data() + keep, input, numSamples);
+
+        juce::FloatVectorOperations::abs(scratch.data(), history.data() + delay - 1, numSamples);
+        juce::FloatVectorOperations::max(peaks, peaks, scratch.data(), numSamples);
+        juce::FloatVectorOperations::abs(scratch.data(), history.data() + delay, numSamples);
+        juce::FloatVectorOperations::max(peaks, peaks, scratch.data(), numSamples);
+
+        for (const auto& kernel : getKernels())
+        {
+            juce::FloatVectorOperations::clear(scratch.data(), numSamples);
+            for (int tap = 0; tap < taps; ++tap)
+                juce::FloatVectorOperations::addWithMultiply(scratch.data(), history.data() + tap, kernel[static_cast<size_t>(tap)], numSamples);
+
+            juce::FloatVectorOperations::abs(scratch.data(), scratch.data(), numSamples);
+            juce::FloatVectorOperations::max(peaks, peaks, scratch.data(), numSamples);
+        }
+
+        std::copy(history.begin() + numSamples, history.begin() + numSamples + keep, history.begin());
+    }
+
+    // Keep the history current without detecting, for when detection resumes
+    void skip(const float* input, int numSamples)
+    {
+        const int keep = taps - 1;
+        if (numSamples >= keep)
+            juce::FloatVectorOperations::copy(history.data(), input + numSamples - keep, keep);
+        else
+        {
+            std::copy(history.begin() + numSamples, history.begin() + keep, history.begin());
+            std::copy(input, input + numSamples, history.begin() + keep - numSamples);
+        }
+    }
+
+private:
+    using Kernels = std::array<std::array<float, taps>, 3>;
+
+    // Windowed-sinc interpolation kernels for the 1/4, 1/2 and 3/4 positions between
+    // history[delay - 1] and history[delay]
+    static const Kernels& getKernels()
+    {
+        static const Kernels kernels = []
+        {
+            Kernels k;
+            for (int phase = 0; phase < 3; ++phase)
+            {
+                const float fraction = 0.25f * (phase + 1);
+                float sum = 0.0f;
+
+                for (int tap = 0; tap < taps; ++tap)
+                {
+                    const float x = (delay - 1) + fraction - tap;
+                    const float sinc = std::sin(juce::MathConstants<float>::pi * x) / (juce::MathConstants<float>::pi * x);
+                    const float window = 0.5f + 0.5f * std::cos(juce::MathConstants<float>::pi * x / delay);
+                    k[phase][tap] = sinc * window;
+                    sum += k[phase][tap];
+                }
+
+                for (auto& coefficient : k[phase])
+                    coefficient /= sum;
+            }
+            return k;
+        }();
+
+        return kernels;
+    }
+
+    std::vector<float> history;
+    std::vector<float> scratch;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TruePeakDetector)
+};
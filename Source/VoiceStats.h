@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    VoiceStats.h
+
+    Voice activity statistics for DUMUMUB wavetable synthesizer.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WavetableSynthesiser.h"
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/**
+ * Voice Stats - Polyphony Usage Counters
+ *
+ * Updated once per block from processBlock, after the voices have rendered:
+ * active and peak voices, voices stolen and notes dropped (counted by the
+ * synthesiser as it allocates), how long notes sound, and what one voice
+ * costs as a fraction of the block's real-time budget. That cost is the
+ * whole renderNextBlock call shared among the voices that sounded, so it
+ * also carries the block's MIDI handling (note allocation, controllers).
+ *
+ * Note lifetimes are measured at block granularity: a note starts in the
+ * block its voice turned active (or changed note) and ends in the block it
+ * went quiet or was stolen, so tails are included. The audio thread is the
+ * only writer; counters are relaxed atomics, and a reset from another thread
+ * is a request picked up at the next block.
+ */
+class VoiceStats
+{
+public:
+    static constexpr int maxVoices = 64;
+
+    struct Snapshot
+    {
+        int activeVoices = 0;
+        int peakVoices = 0;
+        int numVoices = 0;
+        juce::uint64 notesStarted = 0;
+        juce::uint64 voicesStolen = 0;
+        juce::uint64 notesDropped = 0;
+        float averageLifetimeSeconds = 0.0f;
+        float loadPerVoice = 0.0f;        // Fraction of the block budget one voice takes, MIDI handling included (smoothed)
+    };
+
+    VoiceStats()
+    {
+        ticksPerSecond = static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+        voiceNotes.fill(-1);
+        noteStartSamples.fill(0);
+    }
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        requestReset();
+    }
+
+    void requestReset() { resetRequested = true; }
+
+    // Audio thread: update from the voices after renderNextBlock, given the render time
+    void update(WavetableSynthesiser& synthesiser, juce::int64 renderTicks, int numSamples)
+    {
+        if (resetRequested.exchange(false))
+            reset();
+
+        int stolen = 0, dropped = 0;
+        synthesiser.takeAllocationCounts(stolen, dropped);
+
+        const int numVoices = juce::jmin(synthesiser.getNumVoices(), maxVoices);
+        int active = 0;
+        int started = 0;
+
+        for (int i = 0; i < numVoices; ++i)
+        {
+            const auto* voice = synthesiser.getVoice(i);
+            const int note = voice->isVoiceActive() ? voice->getCurrentlyPlayingNote() : -1;
+            auto& previous = voiceNotes[static_cast<size_t>(i)];
+
+            if (note != previous)
+            {
+                // The previous note ended (or was stolen) somewhere in this block
+                if (previous >= 0)
+                {
+                    add(lifetimeSamples, static_cast<juce::uint64>(clock + numSamples - noteStartSamples[static_cast<size_t>(i)]));
+                    add(notesEnded, 1);
+                }
+                if (note >= 0)
+                {
+                    noteStartSamples[static_cast<size_t>(i)] = clock;
+                    ++started;
+                }
+                previous = note;
+            }
+
+            if (note >= 0)
+                ++active;
+        }
+
+        clock += numSamples;
+
+        add(notesStarted, static_cast<juce::uint64>(started));
+        add(voicesStolen, static_cast<juce::uint64>(stolen));
+        add(notesDropped, static_cast<juce::uint64>(dropped));
+        activeVoices.store(active, std::memory_order_relaxed);
+        voiceCount.store(numVoices, std::memory_order_relaxed);
+        if (active > peakVoices.load(std::memory_order_relaxed))
+            peakVoices.store(active, std::memory_order_relaxed);
+
+        // Voices that ended inside the block still rendered part of it
+        const int rendered = juce::jmax(active, lastActive);
+        lastActive = active;
+        if (rendered > 0 && numSamples > 0 && sampleRate > 0.0)
+        {
+            const auto load = static_cast<float>(renderTicks / ticksPerSecond / (numSamples / sampleRate)) / rendered;
+            const float smoothed = loadPerVoice.load(std::memory_order_relaxed);
+            loadPerVoice.store(smoothed > 0.0f ? smoothed + (load - smoothed) * 0.05f : load, std::memory_order_relaxed);
+        }
+    }
+
+    Snapshot getSnapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.activeVoices = activeVoices.load(std::memory_order_relaxed);
+        snapshot.peakVoices = peakVoices.load(std::memory_order_relaxed);
+        snapshot.numVoices = voiceCount.load(std::memory_order_relaxed);
+        snapshot.notesStarted = notesStarted.load(std::memory_order_relaxed);
+        snapshot.voicesStolen = voicesStolen.load(std::memory_order_relaxed);
+        snapshot.notesDropped = notesDropped.load(std::memory_order_relaxed);
+        snapshot.loadPerVoice = loadPerVoice.load(std::memory_order_relaxed);
+
+        const auto ended = notesEnded.load(std::memory_order_relaxed);
+        if (ended > 0 && sampleRate > 0.0)
+            snapshot.averageLifetimeSeconds = static_cast<float>(lifetimeSamples.load(std::memory_order_relaxed) / static_cast<double>(ended) / sampleRate);
+
+        return snapshot;
+    }
+
+private:
+    // Single writer, so no read-modify-write instruction is needed
+    static void add(std::atomic<juce::uint64>& counter, juce::uint64 amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        peakVoices.store(activeVoices.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        notesStarted.store(0, std::memory_order_relaxed);
+        voicesStolen.store(0, std::memory_order_relaxed);
+        notesDropped.store(0, std::memory_order_relaxed);
+        notesEnded.store(0, std::memory_order_relaxed);
+        lifetimeSamples.store(0, std::memory_order_relaxed);
+        loadPerVoice.store(0.0f, std::memory_order_relaxed);
+    }
+
+    double ticksPerSecond = 1.0;
+    double sampleRate = 0.0;
+
+    // Audio thread only
+    std::array<int, maxVoices> voiceNotes;
+    std::array<juce::int64, maxVoices> noteStartSamples;
+    juce::int64 clock = 0;
+    int lastActive = 0;
+
+    std::atomic<int> activeVoices { 0 };
+    std::atomic<int> peakVoices { 0 };
+    std::atomic<int> voiceCount { 0 };
+    std::atomic<juce::uint64> notesStarted { 0 };
+    std::atomic<juce::uint64> voicesStolen { 0 };
+    std::atomic<juce::uint64> notesDropped { 0 };
+    std::atomic<juce::uint64> notesEnded { 0 };
+    std::atomic<juce::uint64> lifetimeSamples { 0 };
+    std::atomic<float> loadPerVoice { 0.0f };
+
+    std::atomic<bool> resetRequested { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceStats)
+};
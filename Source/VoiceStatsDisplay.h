@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    VoiceStatsDisplay.h
+
+    One-line voice activity statistics for the editor's status strip.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+ * Voice Stats Display - One-Line Polyphony Readout
+ *
+ * Sits in the status strip under the artwork, squeezed to fit its width,
+ * and redraws four times a second with the processor's voice statistics.
+ * The capacity estimate divides the timing deadline by the measured cost
+ * of one voice. Double-click resets the counters.
+ */
+class VoiceStatsDisplay  : public juce::Component, private juce::Timer
+{
+public:
+    VoiceStatsDisplay(DUMUMUB003AudioProcessor& p) : audioProcessor(p)
+    {
+        startTimerHz(4);
+    }
+
+    ~VoiceStatsDisplay() override
+    {
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        g.setColour(Colour::fromRGBA(255, 255, 242, 255));
+        Font font(Font::getDefaultSansSerifFontName(), 12.0f, Font::plain);
+        font.setExtraKerningFactor(0.3f);
+        g.setFont(font);
+        g.drawFittedText(text, getLocalBounds(), Justification::centredRight, 1, 0.7f);
+    }
+
+    void mouseDoubleClick (const juce::MouseEvent&) override
+    {
+        audioProcessor.resetVoiceStatistics();
+    }
+
+private:
+    void timerCallback() override
+    {
+        const auto stats = audioProcessor.getVoiceStatistics();
+
+        String newText;
+        newText << "VOICES " << stats.activeVoices << "/" << stats.numVoices
+                << "   PEAK " << stats.peakVoices
+                << "   STOLEN " << String(static_cast<juce::int64>(stats.voicesStolen))
+                << "   DROPPED " << String(static_cast<juce::int64>(stats.notesDropped))
+                << "   AVG NOTE " << String(stats.averageLifetimeSeconds, 2) << " S"
+                << "   " << String(stats.loadPerVoice * 100.0f, 2) << "% PER VOICE";
+
+        if (stats.loadPerVoice > 0.0f)
+        {
+            const float deadline = audioProcessor.getProcessTiming().getDeadlineFraction();
+            newText << " (~" << static_cast<int>(deadline / stats.loadPerVoice) << " FIT)";
+        }
+
+        if (newText != text)
+        {
+            text = newText;
+            repaint();
+        }
+    }
+
+    DUMUMUB003AudioProcessor& audioProcessor;
+    String text;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VoiceStatsDisplay)
+};
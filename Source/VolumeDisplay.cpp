@@ -37,42 +37,64 @@ VolumeDisplay::~VolumeDisplay()
 // Render stereo level meters with color-coded intensity
 void VolumeDisplay::paint (juce::Graphics& g)
 {
-  // Draw level indicators for each interval threshold
-  for (int i = 0; i < intervals.size(); ++i)
-  {
-    // Left channel level display
-    if (audioProcessor.getLoudnessL() > intervals[i])
+    paintChannel(g, ballistics[0], 5);
+    paintChannel(g, ballistics[1], 17);
+
+    // Draw overlay frame on top of level indicators
+    g.drawImageAt(overlay, 0, 0);
+}
+
+void VolumeDisplay::paintChannel(juce::Graphics& g, const LevelMeter::Ballistics& meter, int y)
+{
+    // Draw level indicators for each interval threshold, and the light under the held peak
+    for (int i = 0; i < intervals.size(); ++i)
     {
-      if (i < 13)
-      {
-        g.drawImageAt(greenLight, 5 + (gap * i), 5); // Green for normal levels
-      }
-      else
-      {
-        g.drawImageAt(redLight, 5 + (gap * i), 5); // Red for high levels
-      }
+        const bool lit = meter.level > intervals[i];
+        const bool held = meter.peakHold > intervals[i] && (i + 1 == intervals.size() || meter.peakHold <= intervals[i + 1]);
+
+        if (lit || held)
+            g.drawImageAt(i < 13 ? greenLight : redLight, 5 + (gap * i), y); // Green for normal levels, red for high
     }
+}
 
-    // Right channel level display
-    if (audioProcessor.getLoudnessR() > intervals[i])
+juce::String VolumeDisplay::getTooltip()
+{
+    auto& trace = TraceRecorder::getInstance();
+    if (trace.isRecording())
+        return "Recording trace to " + trace.getFile().getFileName() + " (shift-double-click to stop)";
+
+    return "Audio load: " + audioProcessor.getProcessTiming().getSummary() + " (double-click to save report, shift-double-click to record a trace)";
+}
+
+void VolumeDisplay::mouseDoubleClick (const juce::MouseEvent& event)
+{
+    // Shift toggles a Chrome trace recording
+    if (event.mods.isShiftDown())
     {
-      if (i < 13)
-      {
-        g.drawImageAt(greenLight, 5 + (gap * i), 17); // Green for normal levels
-      }
-      else
-      {
-        g.drawImageAt(redLight, 5 + (gap * i), 17); // Red for high levels
-      }
+        auto& trace = TraceRecorder::getInstance();
+        if (trace.isRecording())
+            trace.stop();
+        else
+            trace.start(juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                            .getNonexistentChildFile("DUMUMUB-003 Trace", ".json"));
+        return;
     }
-  }
 
-    // Draw overlay frame on top of level indicators
-    g.drawImageAt(overlay, 0, 0);
+    const auto file = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+                          .getNonexistentChildFile("DUMUMUB-003 Timing Report", ".txt");
+    audioProcessor.getProcessTiming().writeReport(file);
 }
 
 // Timer callback for smooth real-time level updates
 void VolumeDisplay::timerCallback()
 {
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const float elapsed = lastUpdateTime > 0.0 ? static_cast<float>(now - lastUpdateTime) : 1.0f / 30.0f;
+    lastUpdateTime = now;
+
+    auto& meter = audioProcessor.getOutputMeter();
+    for (int channel = 0; channel < LevelMeter::numChannels; ++channel)
+        ballistics[static_cast<size_t>(channel)].update(meter.getRMS(channel), meter.takePeak(channel), elapsed);
+
     repaint();
 }
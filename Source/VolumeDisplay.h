@@ -21,9 +21,10 @@
  * 
  * Visual level monitoring component that displays left/right channel audio levels
  * using logarithmic scale with color-coded intensity (green/red) indicators.
- * Updates at 30Hz for smooth real-time response.
+ * Updates at 30Hz for smooth real-time response. Attack/release smoothing and
+ * peak hold are applied here, on the GUI side of the processor's meter.
  */
-class VolumeDisplay  : public juce::Component, private juce::Timer
+class VolumeDisplay  : public juce::Component, public juce::TooltipClient, private juce::Timer
 {
 public:
     VolumeDisplay(DUMUMUB003AudioProcessor& p);
@@ -32,10 +33,18 @@ public:
     // Render stereo level meters with color-coded indicators
     void paint (juce::Graphics&) override;
 
+    // processBlock timing summary on hover; double-click writes the full report to Documents,
+    // shift-double-click starts or stops a trace recording there
+    juce::String getTooltip() override;
+    void mouseDoubleClick (const juce::MouseEvent&) override;
+
 private:
     // Timer callback for 30Hz refresh rate
     void timerCallback() override;
 
+    // Draw one channel's row of lights up to its level, plus its held peak
+    void paintChannel(juce::Graphics& g, const LevelMeter::Ballistics& meter, int y);
+
     // Level meter graphics assets
     Image overlay;
     Image greenLight;
@@ -44,6 +53,10 @@ private:
     // Reference to audio processor for level data
     DUMUMUB003AudioProcessor& audioProcessor;
 
+    // Smoothed levels and peak holds for the left and right rows
+    std::array<LevelMeter::Ballistics, 2> ballistics;
+    double lastUpdateTime = 0.0;
+
     // Logarithmic scale intervals for level thresholds
     std::array<float, 16> intervals;
 
@@ -6,7 +6,7 @@
         Author:  Hugh Buntine
 
         Wavetable sound class for DUMUMUB wavetable synthesizer.
-        Defines sound object that responds to all MIDI notes and channels.
+        Defines one sound object per multi-timbral part, addressed by MIDI channel.
 
     ==============================================================================
 */
@@ -17,23 +17,35 @@
 
 //==============================================================================
 /**
- * Wavetable Sound - Universal MIDI Sound Object
+ * Wavetable Sound - Per-Part MIDI Sound Object
  * 
- * Simple sound class that accepts all MIDI notes and channels.
- * Required by JUCE synthesizer framework for polyphonic operation.
- * Works with WavetableVoice to create complete wavetable synthesis system.
+ * One sound exists for each multi-timbral part. In single-part mode only part 0
+ * responds, on every MIDI channel. In multi-timbral mode part N answers
+ * MIDI channel N + 1 only. All parts share the synthesiser's voice pool.
  */
 class WavetableSound : public juce::SynthesiserSound
 {
 public:
-        WavetableSound() {} // Default constructor
+        WavetableSound(int part, const std::atomic<bool>& multiTimbralMode)
+            : partIndex(part), multiTimbral(multiTimbralMode) {}
 
         // Accept all MIDI note numbers for universal playback
         bool appliesToNote (int /*midiNoteNumber*/) override { return true; }
         
-        // Accept all MIDI channels for universal compatibility
-        bool appliesToChannel (int /*midiChannel*/) override { return true; }
+        // Route MIDI channels to parts when multi-timbral, otherwise part 0 takes everything
+        bool appliesToChannel (int midiChannel) override
+        {
+            if (multiTimbral.load(std::memory_order_relaxed))
+                return midiChannel == partIndex + 1;
+
+            return partIndex == 0;
+        }
+
+        int getPartIndex() const { return partIndex; }
 
 private:
+        const int partIndex;
+        const std::atomic<bool>& multiTimbral;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableSound)
 };
\ No newline at end of file
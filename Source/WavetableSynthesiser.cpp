@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    WavetableSynthesiser.cpp
+
+    MPE zone handling and wavetable zone selection for the DUMUMUB wavetable
+    synthesiser.
+
+  ==============================================================================
+*/
+
+#include "WavetableSynthesiser.h"
+#include "WavetableVoice.h"
+
+//==============================================================================
+WavetableSynthesiser::WavetableSynthesiser(const ExpressionSettings& settings, WavetableZoneMap& zoneMap,
+                                           WavetableZoneMap::Reader reader)
+    : expression(settings), zones(zoneMap), zoneReader(reader)
+{
+    lastPressure.fill(0);
+    lastTimbre.fill(0);
+}
+
+void WavetableSynthesiser::noteOn (int midiChannel, int midiNoteNumber, float velocity)
+{
+    // Keyswitches select a slot set and never sound
+    const bool zonesApply = zonesApplyToChannel(midiChannel);
+    if (zonesApply && zones.isKeyswitch(midiNoteNumber))
+    {
+        zones.handleKeyswitch(midiNoteNumber);
+        return;
+    }
+
+    Synthesiser::noteOn(midiChannel, midiNoteNumber, velocity);
+
+    const bool handOverExpression = expression.mpeEnabled && midiChannel >= 1 && midiChannel <= 16;
+    if (!zonesApply && !handOverExpression)
+        return;
+
+    const int slot = zonesApply ? zones.findSlot(zoneReader, midiNoteNumber, juce::roundToInt(velocity * 127.0f)) : -1;
+
+    // Point the voice that just started at its zone's slot, and hand it channel
+    // expression that arrived before the note-on
+    for (int i = 0; i < getNumVoices(); ++i)
+    {
+        auto* voice = dynamic_cast<WavetableVoice*>(getVoice(i));
+        if (voice != nullptr && voice->isKeyDown() && voice->isPlayingChannel(midiChannel)
+            && voice->getCurrentlyPlayingNote() == midiNoteNumber)
+        {
+            if (zonesApply)
+                voice->setZoneSlot(slot);
+            if (handOverExpression)
+                voice->setInitialExpression(lastPressure[midiChannel - 1] / 127.0f, lastTimbre[midiChannel - 1] / 127.0f);
+        }
+    }
+}
+
+void WavetableSynthesiser::handlePitchWheel (int midiChannel, int wheelValue)
+{
+    Synthesiser::handlePitchWheel(midiChannel, wheelValue);
+
+    // Master-channel bend applies to every note in the zone
+    if (isMasterChannel(midiChannel))
+    {
+        for (int i = 0; i < getNumVoices(); ++i)
+            if (auto* voice = dynamic_cast<WavetableVoice*>(getVoice(i)))
+                voice->masterPitchWheelMoved(wheelValue);
+    }
+}
+
+void WavetableSynthesiser::handleController (int midiChannel, int controllerNumber, int controllerValue)
+{
+    if (controllerNumber == 74 && midiChannel >= 1 && midiChannel <= 16)
+        lastTimbre[midiChannel - 1] = controllerValue;
+
+    Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+void WavetableSynthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
+{
+    if (midiChannel >= 1 && midiChannel <= 16)
+        lastPressure[midiChannel - 1] = channelPressureValue;
+
+    Synthesiser::handleChannelPressure(midiChannel, channelPressureValue);
+}
+
+void WavetableSynthesiser::handleProgramChange (int midiChannel, int programNumber)
+{
+    if (zonesApplyToChannel(midiChannel))
+        zones.selectSet(programNumber);
+}
+
+void WavetableSynthesiser::takeAllocationCounts (int& stolen, int& dropped)
+{
+    stolen = voicesStolen;
+    dropped = notesDropped;
+    voicesStolen = 0;
+    notesDropped = 0;
+}
+
+juce::SynthesiserVoice* WavetableSynthesiser::findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                                             int midiNoteNumber, bool stealIfNoneAvailable) const
+{
+    if (auto* voice = Synthesiser::findFreeVoice(soundToPlay, midiChannel, midiNoteNumber, false))
+        return voice;
+
+    // No free voice: steal one if allowed, otherwise the note is dropped
+    auto* stolen = stealIfNoneAvailable ? Synthesiser::findFreeVoice(soundToPlay, midiChannel, midiNoteNumber, true) : nullptr;
+    if (stolen != nullptr)
+        ++voicesStolen;
+    else
+        ++notesDropped;
+
+    return stolen;
+}
+
+bool WavetableSynthesiser::isMasterChannel (int midiChannel) const
+{
+    return expression.mpeEnabled && midiChannel == expression.mpeMasterChannel;
+}
+
+// Zones belong to part 0, so they follow whichever channels its sound answers
+bool WavetableSynthesiser::zonesApplyToChannel (int midiChannel)
+{
+    for (int i = 0; i < getNumSounds(); ++i)
+    {
+        auto* sound = dynamic_cast<WavetableSound*>(getSound(i).get());
+        if (sound != nullptr && sound->getPartIndex() == 0)
+            return sound->appliesToChannel(midiChannel);
+    }
+
+    return false;
+}
@@ -0,0 +1,81 @@
+/*
+  ==============================================================================
+
+    WavetableSynthesiser.h
+
+    Synthesiser subclass for DUMUMUB wavetable synthesizer.
+    Adds MPE zone handling and wavetable zone selection on top of the JUCE
+    synthesiser voice routing.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WavetableZones.h"
+
+//==============================================================================
+// Pitch bend and MPE zone configuration shared by the synthesiser and its voices
+struct ExpressionSettings
+{
+    std::atomic<bool> mpeEnabled { false };
+    std::atomic<int> mpeMasterChannel { 1 };       // 1 = lower zone, 16 = upper zone
+    std::atomic<float> pitchBendRange { 2.0f };    // Semitones for standard and master-channel bend
+    std::atomic<float> mpeNoteBendRange { 48.0f }; // Semitones for per-note bend on member channels
+};
+
+//==============================================================================
+/**
+ * Wavetable Synthesiser - MPE-Aware Voice Routing
+ *
+ * Per-note expression works through JUCE's normal channel routing, since each
+ * MPE note arrives on its own member channel. This class adds the zone-wide
+ * parts: master-channel pitch bend reaches every voice, and pressure/timbre
+ * sent before a note-on are handed to the voice that starts the note.
+ *
+ * It also drives the wavetable zone map for part 0: keyswitch notes and
+ * program changes select the active slot set, and each started note is
+ * pointed at the slot its key and velocity fall in.
+ *
+ * Voice allocation counts how often a note had to steal a voice or found
+ * none at all, for the processor's voice statistics.
+ */
+class WavetableSynthesiser : public juce::Synthesiser
+{
+public:
+    // The zone reader says which of the zone map's pinned banks this synthesiser's notes look up
+    WavetableSynthesiser(const ExpressionSettings& settings, WavetableZoneMap& zoneMap,
+                         WavetableZoneMap::Reader reader = WavetableZoneMap::realtimeReader);
+
+    void noteOn (int midiChannel, int midiNoteNumber, float velocity) override;
+    void handlePitchWheel (int midiChannel, int wheelValue) override;
+    void handleController (int midiChannel, int controllerNumber, int controllerValue) override;
+    void handleChannelPressure (int midiChannel, int channelPressureValue) override;
+    void handleProgramChange (int midiChannel, int programNumber) override;
+
+    // Audio thread: voices stolen and notes dropped since the last call
+    void takeAllocationCounts (int& stolen, int& dropped);
+
+protected:
+    juce::SynthesiserVoice* findFreeVoice (juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                           int midiNoteNumber, bool stealIfNoneAvailable) const override;
+
+private:
+    bool isMasterChannel (int midiChannel) const;
+    bool zonesApplyToChannel (int midiChannel);
+
+    const ExpressionSettings& expression;
+    WavetableZoneMap& zones;
+    const WavetableZoneMap::Reader zoneReader;
+
+    // Last pressure and timbre seen on each channel, for notes that start after them
+    std::array<int, 16> lastPressure;
+    std::array<int, 16> lastTimbre;
+
+    // Counted during allocation (which is const in the base class), taken once per block
+    mutable int voicesStolen = 0;
+    mutable int notesDropped = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableSynthesiser)
+};
@@ -28,13 +28,29 @@
  * - MIDI note frequency conversion
  * - ADSR envelope processing
  * - Real-time gain and output volume control
+ * - Granular playback of the dropped audio buffer
+ * - Per-part tables, envelope and gain for multi-timbral playback
+ * - Key/velocity zone slots that override part 0's tables
+ * - Per-note pitch bend, pressure and timbre with control-rate ramps
+ * - Tuning and smoothing taken from the processor's rate-dependent snapshot
+ * - Held notes that have settled are streamed from a pre-rendered period cache
+ * - Analytic PolyBLEP playback when both tables hold an unmodified basic shape
+ * - Additive resynthesis of the part's tables through inverse-FFT overlap-add
+ * - Phase or ring modulation of each channel's table by the other's
+ * - Sub-oscillator and noise layers sharing the voice envelope and gain
  */
 class WavetableVoice : public juce::SynthesiserVoice
 {
 public:
-    WavetableVoice(DUMUMUB003AudioProcessor& p)
-        : leftPhase(0.0f), rightPhase(0.0f), leftPhaseIncrement(0.0f), rightPhaseIncrement(0.0f), audioProcessor(p)
+    // Offline voices render on a background thread, so they never read the audio thread's rate snapshot
+    WavetableVoice(DUMUMUB003AudioProcessor& p, bool renderingOffline = false)
+        : leftPhase(0.0f), rightPhase(0.0f), phaseIncrement(0.0f), audioProcessor(p), offline(renderingOffline)
     {
+        cacheL.assign(maxCacheLength, 0.0f);
+        cacheR.assign(maxCacheLength, 0.0f);
+
+        // Each voice gets its own noise stream
+        noise.seed(static_cast<juce::uint32>(reinterpret_cast<juce::pointer_sized_uint>(this) >> 4));
     }
 
     // Check if this voice can play the given sound type
@@ -44,35 +60,110 @@ public:
     }
 
     // Initialize voice parameters when MIDI note starts
-    void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound*, int /*currentPitchWheelPosition*/) override
+    void startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition) override
     {
+        DUMUMUB_TRACE_INSTANT ("voice", "start", midiNoteNumber);
+
+        // Take tables, envelope and gain from the part that owns this sound
+        if (auto* wavetableSound = dynamic_cast<WavetableSound*>(sound))
+            partIndex = wavetableSound->getPartIndex();
+        zoneSlot = -1;
+
+        adsrParams = audioProcessor.getPartADSRParameters(partIndex);
         adsr.setParameters(adsrParams);
         adsr.noteOn();
 
-        // Convert MIDI note to frequency and calculate phase increment
+        // Precompute the unbent phase increment from the tuning table
         auto frequency = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber);
-        leftPhaseIncrement = frequency / getSampleRate() * wavetableSize;
-        rightPhaseIncrement = frequency / getSampleRate() * wavetableSize;
+        noteNumber = midiNoteNumber;
+        updateBaseIncrement();
         leftPhase = 0.0f;
         rightPhase = 0.0f;
         level = velocity;
+        modulatorPhase = 0.0f;
+        subPhase = 0.0f;
+        holdCountdown = 0.0f;
+        pinkL.reset();
+        pinkR.reset();
+        additive.reset();
+        invalidatePeriodCache();
+        resetEnvelopeTracking();
+
+        // Reset expression, picking up the bend already sitting on this note's channel
+        noteBend = bendToSemitones(currentPitchWheelPosition, getNoteBendRange());
+        if (!audioProcessor.getExpressionSettings().mpeEnabled)
+            masterBend = 0.0f;
+        pressure = 0.0f;
+        timbre = 0.0f;
+        targetGain = audioProcessor.getPartGain(partIndex) * audioProcessor.getOutputVolume();
+        smoothedGain = targetGain;
+        jumpToExpressionTargets();
+
+        // Grains are transposed relative to middle C as the source's root
+        granularRatio = frequency / juce::MidiMessage::getMidiNoteInHertz(60);
+        granular.reset();
+        granular.setNoteRatio(granularRatio * bendRatio);
     }
 
     // Handle MIDI note release
     void stopNote (float /*velocity*/, bool allowTailOff) override
     {
+        DUMUMUB_TRACE_INSTANT ("voice", "stop", getCurrentlyPlayingNote());
         adsr.noteOff();
+        invalidatePeriodCache();
+        resetEnvelopeTracking();
     
         if (!allowTailOff)
             clearCurrentNote();
     }
-    
-    
 
-    // MIDI controller handling (not implemented)
-    void pitchWheelMoved (int /*newPitchWheelValue*/) override {}
-    void controllerMoved (int /*controllerNumber*/, int /*newControllerValue*/) override {}
+    // Per-note (MPE member channel) or channel-wide pitch bend
+    void pitchWheelMoved (int newPitchWheelValue) override
+    {
+        noteBend = bendToSemitones(newPitchWheelValue, getNoteBendRange());
+    }
+
+    // Zone-wide bend from the MPE master channel, stacked on the note's own bend
+    void masterPitchWheelMoved (int newPitchWheelValue)
+    {
+        masterBend = bendToSemitones(newPitchWheelValue, audioProcessor.getExpressionSettings().pitchBendRange);
+    }
+
+    // CC74 carries MPE timbre
+    void controllerMoved (int controllerNumber, int newControllerValue) override
+    {
+        if (controllerNumber == 74)
+            timbre = newControllerValue / 127.0f;
+    }
+
+    // Channel pressure and polyphonic aftertouch both drive note pressure
+    void channelPressureChanged (int newChannelPressureValue) override { pressure = newChannelPressureValue / 127.0f; }
+    void aftertouchChanged (int newAftertouchValue) override { pressure = newAftertouchValue / 127.0f; }
+
+    // Zone slot chosen by the synthesiser for this note (-1 plays the part tables). Only the
+    // index is kept; its tables are looked up in the bank pinned for each block.
+    void setZoneSlot (int slotIndex)
+    {
+        zoneSlot = slotIndex;
+        invalidatePeriodCache();
+    }
+
+    // Expression that arrived on the channel before this note started
+    void setInitialExpression (float initialPressure, float initialTimbre)
+    {
+        pressure = initialPressure;
+        timbre = initialTimbre;
+        jumpToExpressionTargets();
+    }
     
+    // Envelope timing follows the playback rate
+    void setCurrentPlaybackSampleRate (double newRate) override
+    {
+        SynthesiserVoice::setCurrentPlaybackSampleRate(newRate);
+        if (newRate > 0.0)
+            adsr.setSampleRate(newRate);
+    }
+
     // Check if voice is currently active
     bool isVoiceActive() const override
     {
@@ -85,42 +176,114 @@ public:
         adsrParams = params;
     }
 
+    // Multi-timbral part of the current (or last) note
+    int getPartIndex() const { return partIndex; }
+
     // Core audio rendering with stereo wavetable playback and ADSR envelope
     void renderNextBlock (juce::AudioBuffer<float>& outputBuffer, int startSample, int numSamples) override
     {
-        float gain = audioProcessor.getGain();
+        // Idle voices in the shared pool cost nothing
+        if (!isVoiceActive())
+            return;
+
+        float gain = audioProcessor.getPartGain(partIndex);
         float outputVolume = audioProcessor.getOutputVolume(); // Master volume control
 
+        // Silent parts still run their envelope so the voice is released back to the pool
         if (gain <= 0.0f || level == 0.0f)
+        {
+            for (int sample = 0; sample < numSamples; ++sample)
+                adsr.getNextSample();
+
+            if (!adsr.isActive())
+                clearCurrentNote();
             return;
+        }
 
         auto* leftChannel = outputBuffer.getWritePointer(0, startSample);
         auto* rightChannel = outputBuffer.getWritePointer(1, startSample);
 
+        if (audioProcessor.getOscillatorMode() == DUMUMUB003AudioProcessor::OscillatorMode::granular)
+        {
+            invalidatePeriodCache();
+            renderGranular(leftChannel, rightChannel, numSamples, level * gain * outputVolume);
+
+            if (!adsr.isActive())
+                clearCurrentNote();
+            return;
+        }
+
         // Get wavetable references
-        const auto& leftWavetable = audioProcessor.waveTableL;
-        const auto& rightWavetable = audioProcessor.waveTableR;
+        const auto& leftWavetable = getWaveTableL();
+        const auto& rightWavetable = getWaveTableR();
+        targetGain = gain * outputVolume;
+
+        // Additive mode resynthesises the part's tables (switching in starts from a clean overlap-add)
+        const bool additiveMode = audioProcessor.getOscillatorMode() == DUMUMUB003AudioProcessor::OscillatorMode::additive;
+        if (additiveMode && !additiveActive)
+            additive.reset();
+
+        // Cross-modulation reads the tables directly
+        const auto operatorMode = additiveMode ? DUMUMUB003AudioProcessor::OperatorMode::off : audioProcessor.getOperatorMode();
+        if (operatorMode != operatorActive)
+            invalidatePeriodCache();
+        operatorActive = operatorMode;
+
+        // Otherwise unmodified basic shapes play analytically; zone slots always play their tables
+        const bool analyticAllowed = !additiveMode && operatorMode == DUMUMUB003AudioProcessor::OperatorMode::off && zoneSlot < 0;
+        const auto shapeL = analyticAllowed ? audioProcessor.getAnalyticShape(partIndex, 0) : AnalyticOscillator::Shape::none;
+        const auto shapeR = analyticAllowed ? audioProcessor.getAnalyticShape(partIndex, 1) : AnalyticOscillator::Shape::none;
+        if (shapeL != analyticShapeL || shapeR != analyticShapeR || additiveMode != additiveActive)
+            invalidatePeriodCache();
+        analyticShapeL = shapeL;
+        analyticShapeR = shapeR;
+        additiveActive = additiveMode;
 
-        // Generate audio samples with wavetable interpolation and envelope
-        for (int sample = 0; sample < numSamples; ++sample)
+        // Sub and noise layers make the output aperiodic (noise) or longer than one period (sub)
+        const bool layers = audioProcessor.getSubLevel() > 0.0f || audioProcessor.getNoiseLevel() > 0.0f;
+        if (layers != layersActive)
+            invalidatePeriodCache();
+        layersActive = layers;
+
+        // Generate audio in runs between control ticks, ramping expression linearly within each run
+        int sample = 0;
+        while (sample < numSamples)
         {
-            auto leftSample = leftWavetable[(int)leftPhase];
-            auto rightSample = rightWavetable[(int)rightPhase];
+            if (samplesUntilControlTick == 0)
+                advanceControlTick();
 
-            auto envValue = adsr.getNextSample();
+            const int runStart = sample;
+            const int runEnd = sample + std::min(numSamples - sample, samplesUntilControlTick);
+            const float runIncrement = phaseIncrement;
+            samplesUntilControlTick -= runEnd - sample;
 
-            // Apply velocity, gain, volume, and envelope to output
-            leftChannel[sample] += leftSample * level * gain * outputVolume * envValue;
-            rightChannel[sample] += rightSample * level * gain * outputVolume * envValue;
+            if (cacheLength > 0)
+            {
+                streamPeriodCache(leftChannel + sample, rightChannel + sample, runEnd - sample);
+                sample = runEnd;
+                continue;
+            }
 
-            // Advance wavetable phase with wraparound
-            leftPhase += leftPhaseIncrement;
-            if (leftPhase >= wavetableSize)
-                leftPhase -= wavetableSize;
+            if (operatorActive != DUMUMUB003AudioProcessor::OperatorMode::off)
+            {
+                const bool ring = operatorActive == DUMUMUB003AudioProcessor::OperatorMode::ringModulation;
+                trackEnvelope(ring ? renderOperatorRun<true>(leftChannel + sample, rightChannel + sample, runEnd - sample, leftWavetable, rightWavetable)
+                                   : renderOperatorRun<false>(leftChannel + sample, rightChannel + sample, runEnd - sample, leftWavetable, rightWavetable));
+                sample = runEnd;
+            }
+            else if (additiveActive || isAnalytic())
+            {
+                trackEnvelope(renderGeneratedRun(leftChannel + sample, rightChannel + sample, runEnd - sample));
+                sample = runEnd;
+            }
+            else
+            {
+                renderTableRun(leftChannel, rightChannel, sample, runEnd, leftWavetable, rightWavetable);
+            }
 
-            rightPhase += rightPhaseIncrement;
-            if (rightPhase >= wavetableSize)
-                rightPhase -= wavetableSize;
+            // Layers reuse the run's per-sample envelope and gain from runGain
+            if (layersActive)
+                renderLayers(leftChannel + runStart, rightChannel + runStart, runEnd - runStart, runIncrement);
         }
 
         // Clean up voice when envelope completes
@@ -129,20 +292,607 @@ public:
     }
 
 private:
+    // One control run of plain table playback; leaves sample at runEnd
+    void renderTableRun(float* leftChannel, float* rightChannel, int& sample, int runEnd,
+                        const std::array<float, 1024>& leftWavetable, const std::array<float, 1024>& rightWavetable)
+    {
+        const int runStart = sample;
+        float envelope = 0.0f;
+        for (; sample < runEnd; ++sample)
+        {
+            auto tableL = leftWavetable[(int)leftPhase];
+            auto tableR = rightWavetable[(int)rightPhase];
+
+            // Timbre crossfades each channel toward the opposite table
+            auto leftSample = tableL + timbreMix * (tableR - tableL);
+            auto rightSample = tableR + timbreMix * (tableL - tableR);
+
+            envelope = adsr.getNextSample();
+            auto envValue = envelope * level * expressionGain;
+            runGain[(size_t)(sample - runStart)] = envValue;
+
+            // Apply velocity, gain, volume, pressure and envelope to output
+            leftChannel[sample] += leftSample * envValue;
+            rightChannel[sample] += rightSample * envValue;
+
+            advanceOscillator();
+        }
+
+        trackEnvelope(envelope);
+    }
+
+    // Advance wavetable phase with wraparound (wide bends can exceed one table per sample) and step the ramps
+    void advanceOscillator()
+    {
+        leftPhase += phaseIncrement;
+        while (leftPhase >= wavetableSize)
+            leftPhase -= wavetableSize;
+
+        rightPhase += phaseIncrement;
+        while (rightPhase >= wavetableSize)
+            rightPhase -= wavetableSize;
+
+        phaseIncrement += incrementStep;
+        expressionGain += expressionGainStep;
+        timbreMix += timbreMixStep;
+    }
+
+    // Two run ends at the sustain level mean the envelope has stopped moving
+    void trackEnvelope(float envelope)
+    {
+        envelopeSustained = envelope == adsrParams.sustain && previousRunEnvelope == envelope;
+        previousRunEnvelope = envelope;
+    }
+
+    bool isAnalytic() const
+    {
+        return analyticShapeL != AnalyticOscillator::Shape::none && analyticShapeR != AnalyticOscillator::Shape::none;
+    }
+
+    // One control run from the analytic or additive oscillator: phase, envelope and ramps are
+    // stepped serially, then both channels are generated over the whole run and mixed.
+    // Returns the last envelope value.
+    float renderGeneratedRun(float* leftChannel, float* rightChannel, int numSamples)
+    {
+        const float increment = phaseIncrement;
+        float envelope = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            runSourceL[(size_t)i] = leftPhase;
+            runSourceR[(size_t)i] = rightPhase;
+            envelope = adsr.getNextSample();
+            runGain[(size_t)i] = envelope * level * expressionGain;
+            runMix[(size_t)i] = timbreMix;
+            advanceOscillator();
+        }
+
+        if (additiveActive)
+        {
+            additive.render(runSourceL.data(), runSourceR.data(), numSamples,
+                            audioProcessor.getTableSpectrum(partIndex, 0, offline), audioProcessor.getTableSpectrum(partIndex, 1, offline),
+                            increment, audioProcessor.getAdditiveTilt(), audioProcessor.getAdditiveOddEven(),
+                            audioProcessor.getAdditiveStretch());
+        }
+        else
+        {
+            AnalyticOscillator::render(analyticShapeL, runSourceL.data(), increment, runSourceL.data(), numSamples);
+            AnalyticOscillator::render(analyticShapeR, runSourceR.data(), increment, runSourceR.data(), numSamples);
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float shapeL = runSourceL[(size_t)i];
+            const float shapeR = runSourceR[(size_t)i];
+            const float mix = runMix[(size_t)i];
+            const float envValue = runGain[(size_t)i];
+            leftChannel[i] += (shapeL + mix * (shapeR - shapeL)) * envValue;
+            rightChannel[i] += (shapeR + mix * (shapeL - shapeR)) * envValue;
+        }
+
+        return envelope;
+    }
+
+    // One control run of cross-modulation. Carrier and modulator phases, increment and ramps are
+    // kept in locals for the whole run and both channels are produced in the same loop: each
+    // channel's table is read at the carrier phase, offset (phase modulation) or scaled (ring
+    // modulation) by the opposite channel's table at the modulator phase.
+    template <bool ringModulation>
+    float renderOperatorRun(float* leftChannel, float* rightChannel, int numSamples,
+                            const std::array<float, 1024>& leftWavetable, const std::array<float, 1024>& rightWavetable)
+    {
+        constexpr int tableMask = 1023;
+        const float ratio = audioProcessor.getOperatorRatio();
+        const float index = audioProcessor.getOperatorIndex();
+        const float deviation = index * wavetableSize / juce::MathConstants<float>::twoPi;
+        const float ringDepth = std::min(index, 1.0f);
+
+        float carrier = leftPhase;
+        float modulator = modulatorPhase;
+        float increment = phaseIncrement;
+        float gainNow = expressionGain;
+        float mixNow = timbreMix;
+        float envelope = 0.0f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float modulatorL = leftWavetable[(int)modulator];
+            const float modulatorR = rightWavetable[(int)modulator];
+
+            float tableL, tableR;
+            if (ringModulation)
+            {
+                const float carrierL = leftWavetable[(int)carrier];
+                const float carrierR = rightWavetable[(int)carrier];
+                tableL = carrierL * (1.0f - ringDepth + ringDepth * modulatorR);
+                tableR = carrierR * (1.0f - ringDepth + ringDepth * modulatorL);
+            }
+            else
+            {
+                tableL = leftWavetable[static_cast<size_t>((int)std::floor(carrier + deviation * modulatorR) & tableMask)];
+                tableR = rightWavetable[static_cast<size_t>((int)std::floor(carrier + deviation * modulatorL) & tableMask)];
+            }
+
+            // Timbre crossfades each channel toward the opposite one, as in plain playback
+            const float leftSample = tableL + mixNow * (tableR - tableL);
+            const float rightSample = tableR + mixNow * (tableL - tableR);
+
+            envelope = adsr.getNextSample();
+            const float envValue = envelope * level * gainNow;
+            runGain[(size_t)i] = envValue;
+            leftChannel[i] += leftSample * envValue;
+            rightChannel[i] += rightSample * envValue;
+
+            carrier += increment;
+            while (carrier >= wavetableSize)
+                carrier -= wavetableSize;
+
+            modulator += increment * ratio;
+            while (modulator >= wavetableSize)
+                modulator -= wavetableSize;
+
+            increment += incrementStep;
+            gainNow += expressionGainStep;
+            mixNow += timbreMixStep;
+        }
+
+        leftPhase = rightPhase = carrier;
+        modulatorPhase = modulator;
+        phaseIncrement = increment;
+        expressionGain = gainNow;
+        timbreMix = mixNow;
+        return envelope;
+    }
+
+    // Sub-oscillator and noise layers for one control run, summed in scratch and then put through
+    // the same per-sample envelope and gain (runGain) the run's main oscillator used
+    void renderLayers(float* leftChannel, float* rightChannel, int numSamples, float runIncrement)
+    {
+        const float subLevel = audioProcessor.getSubLevel();
+        const float noiseLevel = audioProcessor.getNoiseLevel();
+        const auto colour = audioProcessor.getNoiseColour();
+        auto* layerL = runSourceL.data();
+        auto* layerR = runSourceR.data();
+
+        if (noiseLevel > 0.0f)
+        {
+            noise.generate(noiseL.data(), numSamples);
+            noise.generate(noiseR.data(), numSamples);
+
+            if (colour == NoiseGenerator::Colour::pink)
+            {
+                pinkL.process(noiseL.data(), numSamples);
+                pinkR.process(noiseR.data(), numSamples);
+            }
+            else if (colour == NoiseGenerator::Colour::sampleAndHold)
+            {
+                // A fresh value from the white stream once per cycle of the note
+                float increment = runIncrement;
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    holdCountdown -= 1.0f;
+                    if (holdCountdown <= 0.0f)
+                    {
+                        heldL = noiseL[(size_t)i];
+                        heldR = noiseR[(size_t)i];
+                        holdCountdown += increment > 0.0f ? wavetableSize / increment : 1.0f;
+                    }
+
+                    noiseL[(size_t)i] = heldL;
+                    noiseR[(size_t)i] = heldR;
+                    increment += incrementStep;
+                }
+            }
+
+            juce::FloatVectorOperations::multiply(layerL, noiseL.data(), noiseLevel, numSamples);
+            juce::FloatVectorOperations::multiply(layerR, noiseR.data(), noiseLevel, numSamples);
+        }
+        else
+        {
+            juce::FloatVectorOperations::clear(layerL, numSamples);
+            juce::FloatVectorOperations::clear(layerR, numSamples);
+        }
+
+        if (subLevel > 0.0f)
+        {
+            // Same tables, one or two octaves down, following the run's pitch ramp
+            const auto& leftWavetable = getWaveTableL();
+            const auto& rightWavetable = getWaveTableR();
+            const float scale = 1.0f / static_cast<float>(1 << audioProcessor.getSubOctaves());
+            float increment = runIncrement * scale;
+            const float step = incrementStep * scale;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                layerL[i] += leftWavetable[(int)subPhase] * subLevel;
+                layerR[i] += rightWavetable[(int)subPhase] * subLevel;
+
+                subPhase += increment;
+                while (subPhase >= wavetableSize)
+                    subPhase -= wavetableSize;
+                increment += step;
+            }
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            leftChannel[i] += layerL[i] * runGain[(size_t)i];
+            rightChannel[i] += layerR[i] * runGain[(size_t)i];
+        }
+    }
+
+    // Granular rendering in scratch-sized chunks with the voice envelope applied on top
+    void renderGranular(float* leftChannel, float* rightChannel, int numSamples, float amplitude)
+    {
+        // Skip the grains (but keep the envelope moving) while a new file is being swapped in.
+        // Offline renders hold the file lock around each block instead, so they never
+        // contend with live voices for the spin lock.
+        const auto& sourceLock = audioProcessor.getDroppedAudioLock();
+        const bool sourceReady = offline || sourceLock.tryEnter();
+        const auto params = audioProcessor.getGranularParameters();
+
+        for (int offset = 0; offset < numSamples; offset += GranularOscillator::maxBlockSize)
+        {
+            const int blockSize = std::min(GranularOscillator::maxBlockSize, numSamples - offset);
+
+            // Grains pick up bend once per chunk; pressure is applied per chunk as well
+            bendRatio = std::exp2((noteBend + masterBend) / 12.0f);
+            granular.setNoteRatio(granularRatio * bendRatio);
+            const float chunkAmplitude = amplitude * (1.0f + pressure);
+
+            if (sourceReady)
+                granular.render(audioProcessor.getDroppedAudio(), audioProcessor.getDroppedAudioSampleRate(),
+                                getSampleRate(), params, granularScratchL.data(), granularScratchR.data(), blockSize);
+            else
+            {
+                juce::FloatVectorOperations::clear(granularScratchL.data(), blockSize);
+                juce::FloatVectorOperations::clear(granularScratchR.data(), blockSize);
+            }
+
+            for (int sample = 0; sample < blockSize; ++sample)
+            {
+                auto envValue = adsr.getNextSample() * chunkAmplitude;
+                leftChannel[offset + sample] += granularScratchL[sample] * envValue;
+                rightChannel[offset + sample] += granularScratchR[sample] * envValue;
+            }
+        }
+
+        if (sourceReady && !offline)
+            sourceLock.exit();
+    }
+
+    // Convert a 14-bit pitch wheel value to semitones
+    static float bendToSemitones(int wheelValue, float range)
+    {
+        return (wheelValue - 8192) / 8192.0f * range;
+    }
+
+    float getNoteBendRange() const
+    {
+        const auto& settings = audioProcessor.getExpressionSettings();
+        return settings.mpeEnabled ? settings.mpeNoteBendRange.load() : settings.pitchBendRange.load();
+    }
+
+    const std::array<float, 1024>& getWaveTableL() const
+    {
+        return zoneSlot >= 0 ? getZoneSlot().tableL : audioProcessor.getPartWaveTableL(partIndex);
+    }
+
+    const std::array<float, 1024>& getWaveTableR() const
+    {
+        return zoneSlot >= 0 ? getZoneSlot().tableR : audioProcessor.getPartWaveTableR(partIndex);
+    }
+
+    const WavetableSlot& getZoneSlot() const
+    {
+        return audioProcessor.getZones().getSlot(offline ? WavetableZoneMap::offlineReader : WavetableZoneMap::realtimeReader, zoneSlot);
+    }
+
+    const RateDependentData* getRateData() const
+    {
+        return offline ? nullptr : audioProcessor.getRateData();
+    }
+
+    // Unbent increment from the current tuning table. If the host changed rate and the
+    // new snapshot is still being built, rescale the old one so pitch stays correct.
+    void updateBaseIncrement()
+    {
+        if (auto* rate = getRateData())
+            baseIncrement = rate->noteIncrements[noteNumber] * static_cast<float>(rate->sampleRate / getSampleRate());
+        else
+            baseIncrement = static_cast<float>(juce::MidiMessage::getMidiNoteInHertz(noteNumber) / getSampleRate() * wavetableSize);
+    }
+
+    // Recompute expression targets once per tick and set up linear ramps toward them
+    void advanceControlTick()
+    {
+        updateBaseIncrement();
+        bendRatio = std::exp2((noteBend + masterBend) / 12.0f);
+
+        // Smooth part gain and master volume changes so slider moves don't zipper
+        if (auto* rate = getRateData())
+            smoothedGain += rate->parameterSmoothing * (targetGain - smoothedGain);
+        else
+            smoothedGain = targetGain;
+
+        // Settle each ramp exactly onto its target so a held note can be recognised as static
+        settle(smoothedGain, targetGain);
+        settle(phaseIncrement, baseIncrement * bendRatio);
+        settle(expressionGain, smoothedGain * (1.0f + pressure));
+        settle(timbreMix, timbre);
+
+        incrementStep = (baseIncrement * bendRatio - phaseIncrement) / controlInterval;
+        expressionGainStep = (smoothedGain * (1.0f + pressure) - expressionGain) / controlInterval;
+        timbreMixStep = (timbre - timbreMix) / controlInterval;
+
+        samplesUntilControlTick = controlInterval;
+        updatePeriodCache();
+    }
+
+    static void settle(float& value, float target)
+    {
+        if (std::abs(target - value) <= 1.0e-6f * std::max(1.0f, std::abs(target)))
+            value = target;
+    }
+
+    //==============================================================================
+    // Period cache: once pitch, gain, timbre, envelope and tables have all held still for a
+    // few ticks, whole periods of the raw (unenveloped) output are rendered once and then
+    // streamed with a vector multiply-add. Any change drops the cache on the next tick.
+    void updatePeriodCache()
+    {
+        // Additive, operator and layered voices are never cached: their output need not repeat per period
+        const auto version = audioProcessor.getTableVersion();
+        const bool isStatic = !additiveActive && !layersActive && operatorActive == DUMUMUB003AudioProcessor::OperatorMode::off && incrementStep == 0.0f && expressionGainStep == 0.0f && timbreMixStep == 0.0f
+                              && envelopeSustained && version == observedTableVersion;
+        observedTableVersion = version;
+
+        if (!isStatic)
+        {
+            invalidatePeriodCache();
+            return;
+        }
+
+        if (cacheLength == 0 && !cacheUnsuitable && ++staticTicks >= staticTicksBeforeCaching)
+            buildPeriodCache();
+    }
+
+    void invalidatePeriodCache()
+    {
+        // envelopeSustained is left alone: it tracks the ADSR, which is only
+        // stepped (and re-measured) while rendering normally
+        cacheLength = 0;
+        staticTicks = 0;
+        cacheUnsuitable = false;
+    }
+
+    void resetEnvelopeTracking()
+    {
+        previousRunEnvelope = -1.0f;
+        envelopeSustained = false;
+    }
+
+    // Pick the whole-sample loop length that ends closest to a period boundary, then
+    // render it from the current phase. Loops whose drift would need re-rendering every
+    // few passes are not worth caching.
+    void buildPeriodCache()
+    {
+        const double period = wavetableSize / static_cast<double>(phaseIncrement);
+        int bestLength = 0;
+        double bestDrift = maxLoopDrift;
+
+        for (int periods = 1; periods <= maxCachedPeriods && period * periods <= maxCacheLength; ++periods)
+        {
+            const int length = static_cast<int>(std::lround(period * periods));
+            const double drift = length * static_cast<double>(phaseIncrement) - periods * wavetableSize;
+            if (length > 0 && std::abs(drift) < std::abs(bestDrift))
+            {
+                bestLength = length;
+                bestDrift = drift;
+            }
+        }
+
+        if (bestLength == 0)
+        {
+            cacheLength = 0;
+            cacheUnsuitable = true;
+            return;
+        }
+
+        // Phases first, then the raw shapes, then the timbre crossfade
+        float cachePhaseL = leftPhase;
+        float cachePhaseR = rightPhase;
+
+        for (int i = 0; i < bestLength; ++i)
+        {
+            cacheL[(size_t)i] = cachePhaseL;
+            cacheR[(size_t)i] = cachePhaseR;
+
+            cachePhaseL += phaseIncrement;
+            while (cachePhaseL >= wavetableSize)
+                cachePhaseL -= wavetableSize;
+
+            cachePhaseR += phaseIncrement;
+            while (cachePhaseR >= wavetableSize)
+                cachePhaseR -= wavetableSize;
+        }
+
+        if (isAnalytic())
+        {
+            AnalyticOscillator::render(analyticShapeL, cacheL.data(), phaseIncrement, cacheL.data(), bestLength);
+            AnalyticOscillator::render(analyticShapeR, cacheR.data(), phaseIncrement, cacheR.data(), bestLength);
+        }
+        else
+        {
+            const auto& leftWavetable = getWaveTableL();
+            const auto& rightWavetable = getWaveTableR();
+
+            for (int i = 0; i < bestLength; ++i)
+            {
+                cacheL[(size_t)i] = leftWavetable[(int)cacheL[(size_t)i]];
+                cacheR[(size_t)i] = rightWavetable[(int)cacheR[(size_t)i]];
+            }
+        }
+
+        for (int i = 0; i < bestLength; ++i)
+        {
+            const float tableL = cacheL[(size_t)i];
+            const float tableR = cacheR[(size_t)i];
+            cacheL[(size_t)i] = tableL + timbreMix * (tableR - tableL);
+            cacheR[(size_t)i] = tableR + timbreMix * (tableL - tableR);
+        }
+
+        cacheLength = bestLength;
+        cachePosition = 0;
+        cacheLoopDrift = static_cast<float>(bestDrift);
+        cachePhaseError = 0.0f;
+    }
+
+    // Copy-and-scale from the cache, keeping the true phase moving so normal rendering
+    // resumes seamlessly and the loop is re-rendered before it drifts off pitch
+    void streamPeriodCache(float* leftChannel, float* rightChannel, int numSamples)
+    {
+        const float amplitude = previousRunEnvelope * level * expressionGain;
+
+        while (numSamples > 0)
+        {
+            const int count = std::min(numSamples, cacheLength - cachePosition);
+            juce::FloatVectorOperations::addWithMultiply(leftChannel, cacheL.data() + cachePosition, amplitude, count);
+            juce::FloatVectorOperations::addWithMultiply(rightChannel, cacheR.data() + cachePosition, amplitude, count);
+
+            leftChannel += count;
+            rightChannel += count;
+            numSamples -= count;
+            cachePosition += count;
+
+            const double advance = static_cast<double>(phaseIncrement) * count;
+            leftPhase = static_cast<float>(std::fmod(leftPhase + advance, static_cast<double>(wavetableSize)));
+            rightPhase = static_cast<float>(std::fmod(rightPhase + advance, static_cast<double>(wavetableSize)));
+
+            if (cachePosition == cacheLength)
+            {
+                cachePosition = 0;
+                cachePhaseError += cacheLoopDrift;
+                if (std::abs(cachePhaseError) >= maxPhaseError)
+                    buildPeriodCache();
+            }
+        }
+    }
+
+    // Snap ramps to their targets (used at note start so notes don't glide in)
+    void jumpToExpressionTargets()
+    {
+        bendRatio = std::exp2((noteBend + masterBend) / 12.0f);
+        phaseIncrement = baseIncrement * bendRatio;
+        expressionGain = smoothedGain * (1.0f + pressure);
+        timbreMix = timbre;
+        incrementStep = expressionGainStep = timbreMixStep = 0.0f;
+        samplesUntilControlTick = 0;
+    }
+
     // Wavetable playback state
     float leftPhase;
     float rightPhase;
-    float leftPhaseIncrement;
-    float rightPhaseIncrement;
+    float phaseIncrement;
+    float baseIncrement = 0.0f;
+    float incrementStep = 0.0f;
     int wavetableSize = 1024;
     float level = 1.0f;
+    int partIndex = 0;
+    int noteNumber = 60;
+    int zoneSlot = -1;
+
+    // Expression state (semitones / 0-1) and control-rate ramps
+    static constexpr int controlInterval = RateDependentData::controlInterval;
+    int samplesUntilControlTick = 0;
+    float noteBend = 0.0f;
+    float masterBend = 0.0f;
+    float pressure = 0.0f;
+    float timbre = 0.0f;
+    float bendRatio = 1.0f;
+    float targetGain = 1.0f;
+    float smoothedGain = 1.0f;
+    float expressionGain = 1.0f;
+    float expressionGainStep = 0.0f;
+    float timbreMix = 0.0f;
+    float timbreMixStep = 0.0f;
+
+    // Analytic and additive playback state, and per-run scratch
+    AnalyticOscillator::Shape analyticShapeL = AnalyticOscillator::Shape::none;
+    AnalyticOscillator::Shape analyticShapeR = AnalyticOscillator::Shape::none;
+    AdditiveOscillator additive;
+    bool additiveActive = false;
+
+    // Cross-modulation state
+    DUMUMUB003AudioProcessor::OperatorMode operatorActive = DUMUMUB003AudioProcessor::OperatorMode::off;
+    float modulatorPhase = 0.0f;
+    std::array<float, controlInterval> runSourceL;
+    std::array<float, controlInterval> runSourceR;
+    std::array<float, controlInterval> runGain;
+    std::array<float, controlInterval> runMix;
+
+    // Sub-oscillator and noise layer state
+    NoiseGenerator noise;
+    NoiseGenerator::PinkFilter pinkL, pinkR;
+    std::array<float, controlInterval> noiseL;
+    std::array<float, controlInterval> noiseR;
+    float subPhase = 0.0f;
+    float holdCountdown = 0.0f;
+    float heldL = 0.0f;
+    float heldR = 0.0f;
+    bool layersActive = false;
+
+    // Period cache state (phase errors in table samples)
+    static constexpr int maxCacheLength = 4096;
+    static constexpr int maxCachedPeriods = 64;
+    static constexpr int staticTicksBeforeCaching = 8;
+    static constexpr double maxLoopDrift = 0.25;
+    static constexpr float maxPhaseError = 1.0f;
+    std::vector<float> cacheL;
+    std::vector<float> cacheR;
+    int cacheLength = 0;
+    int cachePosition = 0;
+    float cacheLoopDrift = 0.0f;
+    float cachePhaseError = 0.0f;
+    int staticTicks = 0;
+    bool cacheUnsuitable = false;
+    juce::uint32 observedTableVersion = 0;
+    float previousRunEnvelope = -1.0f;
+    bool envelopeSustained = false;
 
     // ADSR envelope processing
     ADSR adsr;
     ADSR::Parameters adsrParams;
 
+    // Granular playback state
+    GranularOscillator granular;
+    double granularRatio = 1.0;
+    std::array<float, GranularOscillator::maxBlockSize> granularScratchL;
+    std::array<float, GranularOscillator::maxBlockSize> granularScratchR;
+
     // Reference to audio processor for wavetable data
     DUMUMUB003AudioProcessor& audioProcessor;
+    const bool offline;
 
 
 
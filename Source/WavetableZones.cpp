@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+    WavetableZones.cpp
+
+    Zone editing, lookup and state for the wavetable zone map.
+
+  ==============================================================================
+*/
+
+#include "WavetableZones.h"
+
+//==============================================================================
+WavetableZoneMap::WavetableZoneMap()
+{
+    for (auto& bank : banks)
+    {
+        for (auto& slot : bank.slots)
+        {
+            slot.tableL.fill(0.0f);
+            slot.tableR.fill(0.0f);
+        }
+        bank.slotVersions.fill(0);
+        bank.zoneCounts.fill(0);
+    }
+
+    for (auto& inUse : bankInUse)
+        inUse = -1;
+}
+
+void WavetableZoneMap::writeSlot(Bank& bank, int slotIndex, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    auto& slot = bank.slots[static_cast<size_t>(slotIndex)];
+    slot.tableL = tableL;
+    slot.tableR = tableR;
+    ++bank.slotVersions[static_cast<size_t>(slotIndex)];
+}
+
+int WavetableZoneMap::appendZone(Bank& bank, int set, const WavetableZone& zone,
+                                 const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    const int zoneIndex = bank.zoneCounts[static_cast<size_t>(set)];
+    if (zoneIndex >= maxZonesPerSet)
+        return -1;
+
+    const int slotIndex = getSlotIndex(set, zoneIndex);
+    auto& stored = bank.zones[static_cast<size_t>(slotIndex)];
+    stored.lowKey = juce::jlimit(0, 127, zone.lowKey);
+    stored.highKey = juce::jlimit(stored.lowKey, 127, zone.highKey);
+    stored.lowVelocity = juce::jlimit(1, 127, zone.lowVelocity);
+    stored.highVelocity = juce::jlimit(stored.lowVelocity, 127, zone.highVelocity);
+
+    writeSlot(bank, slotIndex, tableL, tableR);
+    bank.zoneCounts[static_cast<size_t>(set)] = zoneIndex + 1;
+    return zoneIndex;
+}
+
+template <typename Edit>
+void WavetableZoneMap::modify(Edit&& edit)
+{
+    const juce::ScopedLock sl(writeLock);
+
+    // Readers only pin the published bank, so the spare is free once the last one to hold it
+    // has finished its block (at most a block of waiting)
+    const int target = 1 - publishedBank.load();
+    for (;;)
+    {
+        bool pinned = false;
+        for (const auto& inUse : bankInUse)
+            pinned = pinned || inUse.load() == target;
+
+        if (!pinned)
+            break;
+
+        juce::Thread::sleep(1);
+    }
+
+    // The spare is one publish behind, so only the slots changed since then are copied
+    const auto& source = banks[static_cast<size_t>(1 - target)];
+    auto& bank = banks[static_cast<size_t>(target)];
+    for (size_t i = 0; i < static_cast<size_t>(numSlots); ++i)
+    {
+        if (bank.slotVersions[i] != source.slotVersions[i])
+        {
+            bank.slots[i] = source.slots[i];
+            bank.slotVersions[i] = source.slotVersions[i];
+        }
+    }
+    bank.zones = source.zones;
+    bank.zoneCounts = source.zoneCounts;
+
+    edit(bank);
+    publishedBank.store(target);
+}
+
+int WavetableZoneMap::addZone(int set, const WavetableZone& zone, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    if (set < 0 || set >= numSets)
+        return -1;
+
+    int zoneIndex = -1;
+    modify([&] (Bank& bank) { zoneIndex = appendZone(bank, set, zone, tableL, tableR); });
+
+    return zoneIndex;
+}
+
+void WavetableZoneMap::setZoneTables(int set, int zoneIndex, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR)
+{
+    if (set < 0 || set >= numSets)
+        return;
+
+    modify([&] (Bank& bank)
+    {
+        if (zoneIndex >= 0 && zoneIndex < bank.zoneCounts[static_cast<size_t>(set)])
+            writeSlot(bank, getSlotIndex(set, zoneIndex), tableL, tableR);
+    });
+}
+
+void WavetableZoneMap::clearSet(int set)
+{
+    if (set < 0 || set >= numSets)
+        return;
+
+    modify([set] (Bank& bank) { bank.zoneCounts[static_cast<size_t>(set)] = 0; });
+}
+
+int WavetableZoneMap::getNumZones(int set) const
+{
+    if (set < 0 || set >= numSets)
+        return 0;
+
+    const juce::ScopedLock sl(writeLock);
+    return getPublishedBank().zoneCounts[static_cast<size_t>(set)];
+}
+
+//==============================================================================
+bool WavetableZoneMap::isKeyswitch(int midiNoteNumber) const
+{
+    const int base = keyswitchBase;
+    return keyswitchesEnabled && midiNoteNumber >= base && midiNoteNumber < base + numSets;
+}
+
+void WavetableZoneMap::acquire(Reader reader) noexcept
+{
+    // Hazard pointer: re-check after announcing, in case a publish landed in between
+    auto& inUse = bankInUse[static_cast<size_t>(reader)];
+    int bank = publishedBank.load();
+    for (;;)
+    {
+        inUse.store(bank);
+        const int latest = publishedBank.load();
+        if (latest == bank)
+            break;
+        bank = latest;
+    }
+
+    pinnedBank[static_cast<size_t>(reader)] = bank;
+}
+
+int WavetableZoneMap::findSlot(Reader reader, int midiNoteNumber, int velocity) const noexcept
+{
+    const auto& bank = banks[static_cast<size_t>(pinnedBank[static_cast<size_t>(reader)])];
+    const int set = activeSet;
+
+    // First matching zone wins, so zones added earlier take priority on overlaps
+    for (int i = 0; i < bank.zoneCounts[static_cast<size_t>(set)]; ++i)
+    {
+        const int slotIndex = getSlotIndex(set, i);
+        const auto& zone = bank.zones[static_cast<size_t>(slotIndex)];
+        if (midiNoteNumber >= zone.lowKey && midiNoteNumber <= zone.highKey
+            && velocity >= zone.lowVelocity && velocity <= zone.highVelocity)
+            return slotIndex;
+    }
+
+    return -1;
+}
+
+const WavetableSlot& WavetableZoneMap::getSlot(Reader reader, int slotIndex) const noexcept
+{
+    jassert (slotIndex >= 0 && slotIndex < numSlots);
+    return banks[static_cast<size_t>(pinnedBank[static_cast<size_t>(reader)])].slots[static_cast<size_t>(slotIndex)];
+}
+
+//==============================================================================
+void WavetableZoneMap::writeState(juce::XmlElement& parent) const
+{
+    auto* xml = parent.createNewChildElement("Zones");
+    xml->setAttribute("activeSet", activeSet.load());
+    xml->setAttribute("keyswitchesEnabled", keyswitchesEnabled.load());
+    xml->setAttribute("keyswitchBase", keyswitchBase.load());
+
+    // Holding the write lock keeps the published bank from being recycled while it is read
+    const juce::ScopedLock sl(writeLock);
+    const auto& bank = getPublishedBank();
+
+    for (int set = 0; set < numSets; ++set)
+    {
+        for (int i = 0; i < bank.zoneCounts[static_cast<size_t>(set)]; ++i)
+        {
+            const int slotIndex = getSlotIndex(set, i);
+            const auto& zone = bank.zones[static_cast<size_t>(slotIndex)];
+            const auto& slot = bank.slots[static_cast<size_t>(slotIndex)];
+
+            auto* zoneXml = xml->createNewChildElement("Zone");
+            zoneXml->setAttribute("set", set);
+            zoneXml->setAttribute("lowKey", zone.lowKey);
+            zoneXml->setAttribute("highKey", zone.highKey);
+            zoneXml->setAttribute("lowVelocity", zone.lowVelocity);
+            zoneXml->setAttribute("highVelocity", zone.highVelocity);
+            zoneXml->setAttribute("waveTableL", juce::MemoryBlock(slot.tableL.data(), sizeof(slot.tableL)).toBase64Encoding());
+            zoneXml->setAttribute("waveTableR", juce::MemoryBlock(slot.tableR.data(), sizeof(slot.tableR)).toBase64Encoding());
+        }
+    }
+}
+
+void WavetableZoneMap::readState(const juce::XmlElement& parent)
+{
+    auto* xml = parent.getChildByName("Zones");
+
+    selectSet(xml != nullptr ? xml->getIntAttribute("activeSet", 0) : 0);
+    setKeyswitchesEnabled(xml != nullptr && xml->getBoolAttribute("keyswitchesEnabled", false));
+    if (xml != nullptr)
+        setKeyswitchBase(xml->getIntAttribute("keyswitchBase", 24));
+
+    // The whole restore is one publish, so readers never see a half-restored map
+    modify([xml] (Bank& bank)
+    {
+        bank.zoneCounts.fill(0);
+        if (xml == nullptr)
+            return;
+
+        std::array<float, 1024> tableL, tableR;
+        juce::MemoryBlock tableData;
+
+        for (auto* zoneXml : xml->getChildWithTagNameIterator("Zone"))
+        {
+            const int set = zoneXml->getIntAttribute("set", 0);
+            if (set < 0 || set >= numSets)
+                continue;
+
+            WavetableZone zone;
+            zone.lowKey = zoneXml->getIntAttribute("lowKey", 0);
+            zone.highKey = zoneXml->getIntAttribute("highKey", 127);
+            zone.lowVelocity = zoneXml->getIntAttribute("lowVelocity", 1);
+            zone.highVelocity = zoneXml->getIntAttribute("highVelocity", 127);
+
+            tableL.fill(0.0f);
+            tableR.fill(0.0f);
+            if (tableData.fromBase64Encoding(zoneXml->getStringAttribute("waveTableL")) && tableData.getSize() == sizeof(tableL))
+                std::memcpy(tableL.data(), tableData.getData(), sizeof(tableL));
+            if (tableData.fromBase64Encoding(zoneXml->getStringAttribute("waveTableR")) && tableData.getSize() == sizeof(tableR))
+                std::memcpy(tableR.data(), tableData.getData(), sizeof(tableR));
+
+            appendZone(bank, set, zone, tableL, tableR);
+        }
+    });
+}
@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    WavetableZones.h
+
+    Key-range and velocity zones for DUMUMUB wavetable synthesizer.
+    Maps each note-on to a pre-built wavetable slot in the active slot set.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+
+//==============================================================================
+// One pre-built stereo table pair
+struct WavetableSlot
+{
+    std::array<float, 1024> tableL;
+    std::array<float, 1024> tableR;
+};
+
+// Inclusive key and velocity (1-127) range answered by one slot
+struct WavetableZone
+{
+    int lowKey = 0;
+    int highKey = 127;
+    int lowVelocity = 1;
+    int highVelocity = 127;
+};
+
+//==============================================================================
+/**
+ * Wavetable Zone Map - Keyswitched Sets of Key/Velocity Zones
+ *
+ * Holds numSets slot sets of up to maxZonesPerSet zones. Every slot lives in
+ * one fixed, contiguous bank, and the map keeps two banks. Edits bring the
+ * spare bank up to date, change it and publish it; readers never see a bank
+ * being written.
+ *
+ * Each reader (the live engine and the offline renderer) pins the published
+ * bank for the length of a block. Note-on scans the pinned bank's zones and
+ * hands the voice a slot index, and the voice turns that index into a table
+ * pointer in whichever bank is pinned for the block it renders. Nothing is
+ * built, allocated, locked or reference-counted on the audio thread; held
+ * notes follow edits to their zone at the next block, as they do for the
+ * part tables. Cleared slots keep their tables, so a note still holding one
+ * plays on until it ends.
+ *
+ * Keyswitch notes (numSets keys from the keyswitch base) and program changes
+ * 0..numSets-1 select the active set. If no zone matches, the note plays the
+ * part's own tables.
+ */
+class WavetableZoneMap
+{
+public:
+    static constexpr int numSets = 8;
+    static constexpr int maxZonesPerSet = 16;
+    static constexpr int numSlots = numSets * maxZonesPerSet;
+
+    // Threads that read slots, each pinning its own bank
+    enum Reader { realtimeReader = 0, offlineReader, numReaders };
+
+    WavetableZoneMap();
+
+    //==============================================================================
+    // Editing (message thread). addZone returns the zone index, or -1 if the set is full.
+    int addZone(int set, const WavetableZone& zone, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+    void setZoneTables(int set, int zoneIndex, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+    void clearSet(int set);
+    int getNumZones(int set) const;
+
+    void setKeyswitchesEnabled(bool shouldBeEnabled) { keyswitchesEnabled = shouldBeEnabled; }
+    bool areKeyswitchesEnabled() const { return keyswitchesEnabled; }
+    void setKeyswitchBase(int note) { keyswitchBase = juce::jlimit(0, 128 - numSets, note); }
+    int getKeyswitchBase() const { return keyswitchBase; }
+
+    //==============================================================================
+    // Set selection (audio or message thread)
+    void selectSet(int set) { if (set >= 0 && set < numSets) activeSet = set; }
+    int getActiveSet() const { return activeSet; }
+    bool isKeyswitch(int midiNoteNumber) const;
+    void handleKeyswitch(int midiNoteNumber) { selectSet(midiNoteNumber - keyswitchBase); }
+
+    //==============================================================================
+    // Reader thread: pin the published bank for one block, and let go of it afterwards
+    void acquire(Reader reader) noexcept;
+    void release(Reader reader) noexcept { bankInUse[static_cast<size_t>(reader)].store(-1); }
+
+    // Reader thread, while pinned: slot index for a note in the active set, or -1 to use the
+    // part tables, and the tables for an index
+    int findSlot(Reader reader, int midiNoteNumber, int velocity) const noexcept;
+    const WavetableSlot& getSlot(Reader reader, int slotIndex) const noexcept;
+
+    //==============================================================================
+    void writeState(juce::XmlElement& parent) const;
+    void readState(const juce::XmlElement& parent);
+
+private:
+    struct Bank
+    {
+        std::array<WavetableSlot, numSlots> slots;      // Set-major: set * maxZonesPerSet + zone
+        std::array<juce::uint32, numSlots> slotVersions;
+        std::array<WavetableZone, numSlots> zones;
+        std::array<int, numSets> zoneCounts;
+    };
+
+    static int getSlotIndex(int set, int zoneIndex) { return set * maxZonesPerSet + zoneIndex; }
+    static void writeSlot(Bank& bank, int slotIndex, const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+    static int appendZone(Bank& bank, int set, const WavetableZone& zone,
+                          const std::array<float, 1024>& tableL, const std::array<float, 1024>& tableR);
+
+    // Writer side: bring the spare bank up to date, apply the edit to it and publish it
+    template <typename Edit>
+    void modify(Edit&& edit);
+    const Bank& getPublishedBank() const { return banks[static_cast<size_t>(publishedBank.load())]; }
+
+    std::array<Bank, 2> banks;
+    std::atomic<int> publishedBank { 0 };
+    std::array<std::atomic<int>, numReaders> bankInUse;
+    std::array<int, numReaders> pinnedBank {};     // Each entry touched only by its reader
+    juce::CriticalSection writeLock;                // Serialises editors; readers never take it
+
+    std::atomic<int> activeSet { 0 };
+    std::atomic<bool> keyswitchesEnabled { false };
+    std::atomic<int> keyswitchBase { 24 }; // C0
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableZoneMap)
+};